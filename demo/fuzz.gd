@@ -0,0 +1,53 @@
+# Replays the fixed regression cases, then fuzzes the triangulation with a
+# debug build of the extension, printing each failure and exiting with a
+# non-zero status if a regression case failed or a fuzzed case was invalid
+# or hung, so CI can run it:
+#
+#   godot --headless --path demo -s fuzz.gd
+#
+# FUZZ_SECONDS (default 60) and FUZZ_SEED (default the time) in the
+# environment set how long it runs and which cases it generates; the same
+# seed generates the same cases. A failure replays with
+# DelaunatorFuzzer.generate(generator, case_seed, original_size).
+#
+# Slow cases are only reported, as their timing depends on the machine and
+# whatever else it's running.
+extends SceneTree
+
+func _init():
+	if not ClassDB.class_exists("DelaunatorFuzzer"):
+		printerr("fuzz.gd: DelaunatorFuzzer is missing; it's only in debug builds of the extension.")
+		quit(1)
+		return
+
+	var fuzzer = ClassDB.instantiate("DelaunatorFuzzer")
+	var failed = false
+	for regression in fuzzer.check_regressions():
+		printerr("fuzz.gd: regression case failed: %s" % regression)
+		failed = true
+
+	var seconds = OS.get_environment("FUZZ_SECONDS")
+	fuzzer.duration = float(seconds) if seconds.is_valid_float() else 60.0
+	var fuzz_seed = OS.get_environment("FUZZ_SEED")
+	fuzzer.seed = int(fuzz_seed) if fuzz_seed.is_valid_int() else int(Time.get_unix_time_from_system())
+	print("fuzz.gd: seed %d for %.0f seconds" % [fuzzer.seed, fuzzer.duration])
+
+	var hung = false
+	for failure in fuzzer.run():
+		var line = "fuzz.gd: %s failure from %s, case_seed %d, %d points (%d after minimizing): %s" % [
+			failure["kind"], failure["generator"], failure["case_seed"], failure["original_size"],
+			failure["points"].size(), failure["message"]]
+		if failure["kind"] == "slow":
+			print(line)
+		else:
+			printerr(line)
+			failed = true
+			hung = hung or failure["kind"] == "hang"
+	print("fuzz.gd: %d cases" % fuzzer.cases_run)
+
+	if hung:
+		# The hung case is still running on a thread of its own, which would
+		# crash as quit() unloads the extension under it, so the process is
+		# ended without unloading anything.
+		OS.kill(OS.get_process_id())
+	quit(1 if failed else 0)
@@ -0,0 +1,73 @@
+#include "alpha_shape.hpp"
+
+#include "delaunator_predicates.hpp"
+
+namespace delaunator_cpp {
+
+void circumradii(const Delaunator& delaunator, std::vector<double>& radii)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const godot::Vector2 *points = delaunator.m_points.ptr();
+
+    radii.resize(triangles.size() / 3);
+    for (std::size_t t = 0; t < radii.size(); t++) {
+        radii[t] = circumradius(
+            points[triangles[3 * t]],
+            points[triangles[3 * t + 1]],
+            points[triangles[3 * t + 2]]);
+    }
+}
+
+std::vector<std::vector<std::size_t>> alpha_shape(
+    const Delaunator& delaunator,
+    const std::vector<double>& radii,
+    double alpha)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const std::vector<std::size_t>& halfedges = delaunator.halfedges;
+    // a negative alpha would square to the same shape as its opposite
+    if (!(alpha >= 0.0)) return {};
+    const double alpha2 = alpha * alpha;
+
+    std::vector<bool> kept(radii.size());
+    for (std::size_t t = 0; t < radii.size(); t++) {
+        kept[t] = radii[t] <= alpha2;
+    }
+
+    // a boundary halfedge belongs to a kept triangle, and its opposite
+    // halfedge is either missing (convex hull) or in a discarded triangle
+    auto is_boundary = [&](std::size_t e) {
+        if (!kept[e / 3]) return false;
+        const std::size_t opposite = halfedges[e];
+        return opposite == INVALID_INDEX || !kept[opposite / 3];
+    };
+
+    std::vector<std::vector<std::size_t>> loops;
+    std::vector<bool> visited(triangles.size(), false);
+
+    for (std::size_t e = 0; e < triangles.size(); e++) {
+        if (visited[e] || !is_boundary(e)) continue;
+
+        std::vector<std::size_t> loop;
+        std::size_t b = e;
+        do {
+            visited[b] = true;
+            loop.push_back(triangles[b]);
+
+            // Rotate through the kept triangles around the end point of b
+            // until the next boundary halfedge leaving that point is found.
+            // Taking the first one in the fan keeps loops that touch at a
+            // single point separate.
+            std::size_t c = next_halfedge(b);
+            while (!is_boundary(c)) {
+                c = next_halfedge(halfedges[c]);
+            }
+            b = c;
+        } while (b != e);
+
+        loops.push_back(std::move(loop));
+    }
+    return loops;
+}
+
+} //namespace delaunator_cpp
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// Fills 'radii' with the squared circumradius of every triangle, indexed by
+// triangle (halfedge / 3). Degenerate triangles get double's max value.
+void circumradii(const Delaunator& delaunator, std::vector<double>& radii);
+
+// Returns the boundary loops of the alpha shape: the union of the triangles
+// whose circumradius is no greater than 'alpha'. 'radii' is the output of
+// circumradii(), so changing alpha only re-filters the triangles.
+//
+// Each loop is a ring of point indices which follows the winding of the
+// triangles, so outer boundaries and holes wind in opposite directions.
+// A negative (or NaN) alpha gives no loops.
+std::vector<std::vector<std::size_t>> alpha_shape(
+    const Delaunator& delaunator,
+    const std::vector<double>& radii,
+    double alpha);
+
+} //namespace delaunator_cpp
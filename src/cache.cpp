@@ -0,0 +1,453 @@
+#include "cache.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace delaunator_cpp {
+
+namespace {
+
+const char CACHE_MAGIC[8] = { 'G', 'D', 'D', 'E', 'L', 'A', 'U', 'N' };
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr std::uint32_t NO_INDEX = 0xFFFFFFFF;
+constexpr std::uint64_t ALIGNMENT = 16;
+
+enum Section {
+    SECTION_POINTS,        // real_t x, y per point
+    SECTION_TRIANGLES,     // uint32 per index
+    SECTION_HALFEDGES,     // uint32 per index, NO_INDEX for hull edges
+    SECTION_HULL,          // uint32 point per hull point, in hull order
+    SECTION_HULL_TRI,      // uint32 halfedge per hull point
+    SECTION_SKIPPED,       // uint32 per point the sweep skipped
+    SECTION_CIRCUMCENTERS, // real_t x, y per triangle (optional)
+    SECTION_INEDGES,       // uint32 per point (optional)
+    SECTION_WRAP_OFFSETS,  // int8 x, y per index (optional)
+    SECTION_POINT_REMAP,   // uint32 per point (optional)
+    SECTION_COUNT
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t real_size;
+    std::uint32_t mode; // a CacheMode
+    std::uint64_t points_hash;
+    std::uint64_t point_count;
+    std::uint64_t index_count;
+    std::uint64_t hull_size;
+    std::uint64_t skipped_count;
+    double tolerance;
+    double periodic_size[2];
+    // byte offset and size of each section, 0 for sections not stored
+    std::uint64_t offsets[SECTION_COUNT];
+    std::uint64_t sizes[SECTION_COUNT];
+};
+
+inline std::uint64_t align(std::uint64_t offset)
+{
+    return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+// A read-only view of a whole file, mapped into memory
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path)
+    {
+#ifdef _WIN32
+        const int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, NULL, 0);
+        std::wstring wide_path(length, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wide_path[0], length);
+
+        m_file = CreateFileW(wide_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (m_file == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) return;
+        m_mapping = CreateFileMappingW(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m_mapping == NULL) return;
+        m_data = static_cast<const unsigned char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_data) m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+        m_fd = open(path.c_str(), O_RDONLY);
+        if (m_fd < 0) return;
+        struct stat info;
+        if (fstat(m_fd, &info) != 0 || info.st_size == 0) return;
+        void *data = mmap(NULL, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (data == MAP_FAILED) return;
+        m_data = static_cast<const unsigned char *>(data);
+        m_size = static_cast<std::size_t>(info.st_size);
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifdef _WIN32
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mapping != NULL) CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+        if (m_data) munmap(const_cast<unsigned char *>(m_data), m_size);
+        if (m_fd >= 0) close(m_fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char *data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+private:
+    const unsigned char *m_data = nullptr;
+    std::size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = NULL;
+#else
+    int m_fd = -1;
+#endif
+};
+
+CacheStatus read_header(const MappedFile& file, Header& header)
+{
+    if (!file.data()) return CacheStatus::CANT_OPEN;
+    if (file.size() < sizeof(Header)) return CacheStatus::UNRECOGNIZED;
+
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != CACHE_VERSION ||
+        header.byte_order != BYTE_ORDER_MARK ||
+        header.real_size != sizeof(real_t)) {
+        return CacheStatus::UNRECOGNIZED;
+    }
+    if (header.mode > static_cast<std::uint32_t>(CacheMode::PERIODIC)) return CacheStatus::CORRUPT;
+    return CacheStatus::OK;
+}
+
+// Widens a uint32 section into indices, checking each is below 'limit'
+bool read_indices(const unsigned char *section, std::size_t count, std::size_t limit, bool allow_invalid, std::vector<std::size_t>& out)
+{
+    const std::uint32_t *values = reinterpret_cast<const std::uint32_t *>(section);
+    out.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        if (values[i] == NO_INDEX && allow_invalid) {
+            out[i] = INVALID_INDEX;
+        } else if (values[i] < limit) {
+            out[i] = values[i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+std::uint64_t hash_points(const godot::PackedVector2Array& points)
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(points.ptr());
+    const std::size_t size = static_cast<std::size_t>(points.size()) * sizeof(godot::Vector2);
+
+    std::uint64_t hash = 0x9E3779B97F4A7C15ull ^ size;
+    auto mix = [&hash](std::uint64_t word) {
+        hash ^= word * 0xFF51AFD7ED558CCDull;
+        hash = ((hash << 27) | (hash >> 37)) * 0xC4CEB9FE1A85EC53ull;
+    };
+
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        mix(word);
+    }
+    if (i < size) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes + i, size - i);
+        mix(word);
+    }
+
+    // final avalanche, from splitmix64
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+CacheStatus save_triangulation(
+    const std::string& path,
+    const Delaunator& delaunator,
+    const CacheExtras& extras)
+{
+    const std::size_t point_count = delaunator.m_points.size();
+    const std::size_t index_count = delaunator.triangles.size();
+    if (point_count >= NO_INDEX || index_count >= NO_INDEX) return CacheStatus::CANT_WRITE;
+
+    std::vector<std::uint32_t> hull;
+    std::vector<std::uint32_t> hull_tri;
+    if (delaunator.hull_start != INVALID_INDEX) {
+        std::size_t e = delaunator.hull_start;
+        do {
+            hull.push_back(static_cast<std::uint32_t>(e));
+            hull_tri.push_back(static_cast<std::uint32_t>(delaunator.hull_tri[e]));
+            e = delaunator.hull_next[e];
+        } while (e != delaunator.hull_start);
+    }
+
+    auto narrow = [](const std::vector<std::size_t>& indices) {
+        std::vector<std::uint32_t> result(indices.size());
+        for (std::size_t i = 0; i < indices.size(); i++) {
+            result[i] = indices[i] == INVALID_INDEX ? NO_INDEX : static_cast<std::uint32_t>(indices[i]);
+        }
+        return result;
+    };
+    const std::vector<std::uint32_t> triangles = narrow(delaunator.triangles);
+    const std::vector<std::uint32_t> halfedges = narrow(delaunator.halfedges);
+    const std::vector<std::uint32_t> inedges = narrow(extras.inedges);
+    const std::vector<std::uint32_t> skipped = narrow(delaunator.skipped);
+    const std::vector<std::uint32_t> point_remap = narrow(extras.point_remap);
+    if (!point_remap.empty() && point_remap.size() != point_count) return CacheStatus::CANT_WRITE;
+
+    std::vector<std::int8_t> wrap_offsets(2 * extras.wrap_offsets.size());
+    for (std::size_t i = 0; i < extras.wrap_offsets.size(); i++) {
+        // only a very narrow periodic domain has triangles reaching this far
+        if (std::abs(extras.wrap_offsets[i].x) > INT8_MAX || std::abs(extras.wrap_offsets[i].y) > INT8_MAX) {
+            return CacheStatus::CANT_WRITE;
+        }
+        wrap_offsets[2 * i] = static_cast<std::int8_t>(extras.wrap_offsets[i].x);
+        wrap_offsets[2 * i + 1] = static_cast<std::int8_t>(extras.wrap_offsets[i].y);
+    }
+
+    const void *sections[SECTION_COUNT] = {
+        delaunator.m_points.ptr(),
+        triangles.data(),
+        halfedges.data(),
+        hull.data(),
+        hull_tri.data(),
+        skipped.data(),
+        extras.circumcenters.data(),
+        inedges.data(),
+        wrap_offsets.data(),
+        point_remap.data()
+    };
+
+    Header header = {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.real_size = sizeof(real_t);
+    header.mode = static_cast<std::uint32_t>(extras.mode);
+    header.points_hash = hash_points(delaunator.m_points);
+    header.point_count = point_count;
+    header.index_count = index_count;
+    header.hull_size = hull.size();
+    header.skipped_count = skipped.size();
+    header.tolerance = extras.tolerance;
+    header.periodic_size[0] = extras.periodic_size.x;
+    header.periodic_size[1] = extras.periodic_size.y;
+    header.sizes[SECTION_POINTS] = point_count * sizeof(godot::Vector2);
+    header.sizes[SECTION_TRIANGLES] = triangles.size() * sizeof(std::uint32_t);
+    header.sizes[SECTION_HALFEDGES] = halfedges.size() * sizeof(std::uint32_t);
+    header.sizes[SECTION_HULL] = hull.size() * sizeof(std::uint32_t);
+    header.sizes[SECTION_HULL_TRI] = hull_tri.size() * sizeof(std::uint32_t);
+    header.sizes[SECTION_SKIPPED] = skipped.size() * sizeof(std::uint32_t);
+    header.sizes[SECTION_CIRCUMCENTERS] = extras.circumcenters.size() * sizeof(godot::Vector2);
+    header.sizes[SECTION_INEDGES] = inedges.size() * sizeof(std::uint32_t);
+    header.sizes[SECTION_WRAP_OFFSETS] = wrap_offsets.size();
+    header.sizes[SECTION_POINT_REMAP] = point_remap.size() * sizeof(std::uint32_t);
+
+    std::uint64_t offset = align(sizeof(Header));
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        if (header.sizes[s] == 0) continue;
+        header.offsets[s] = offset;
+        offset = align(offset + header.sizes[s]);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return CacheStatus::CANT_OPEN;
+
+    const char padding[ALIGNMENT] = {};
+    std::uint64_t written = sizeof(Header);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        if (header.sizes[s] == 0) continue;
+        file.write(padding, header.offsets[s] - written);
+        file.write(static_cast<const char *>(sections[s]), header.sizes[s]);
+        written = header.offsets[s] + header.sizes[s];
+    }
+    file.write(padding, align(written) - written);
+
+    return file ? CacheStatus::OK : CacheStatus::CANT_WRITE;
+}
+
+CacheStatus read_cache_info(const std::string& path, CacheInfo& info)
+{
+    MappedFile file(path);
+    Header header;
+    const CacheStatus status = read_header(file, header);
+    if (status != CacheStatus::OK) return status;
+    info.points_hash = header.points_hash;
+    info.mode = static_cast<CacheMode>(header.mode);
+    info.tolerance = header.tolerance;
+    return CacheStatus::OK;
+}
+
+CacheStatus load_triangulation(
+    const std::string& path,
+    Delaunator& delaunator,
+    CacheExtras& extras)
+{
+    MappedFile file(path);
+    Header header;
+    const CacheStatus status = read_header(file, header);
+    if (status != CacheStatus::OK) return status;
+
+    const std::uint64_t point_count = header.point_count;
+    const std::uint64_t index_count = header.index_count;
+    const std::uint64_t hull_size = header.hull_size;
+    const std::uint64_t skipped_count = header.skipped_count;
+    const bool hull_only = header.mode == static_cast<std::uint32_t>(CacheMode::HULL);
+    if (point_count >= NO_INDEX || index_count >= NO_INDEX || index_count % 3 != 0 || hull_size > point_count ||
+        skipped_count > point_count || (hull_only && index_count != 0)) {
+        return CacheStatus::CORRUPT;
+    }
+
+    // every section must be where it can be read in place, and of the size
+    // the counts say (or absent, for the optional ones)
+    const std::uint64_t expected_sizes[SECTION_COUNT] = {
+        point_count * sizeof(godot::Vector2),
+        index_count * sizeof(std::uint32_t),
+        index_count * sizeof(std::uint32_t),
+        hull_size * sizeof(std::uint32_t),
+        hull_size * sizeof(std::uint32_t),
+        skipped_count * sizeof(std::uint32_t),
+        index_count / 3 * sizeof(godot::Vector2),
+        point_count * sizeof(std::uint32_t),
+        index_count * 2,
+        point_count * sizeof(std::uint32_t)
+    };
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        const std::uint64_t size = header.sizes[s];
+        if (size == 0 && (s >= SECTION_CIRCUMCENTERS || expected_sizes[s] == 0)) continue;
+        if (size != expected_sizes[s] ||
+            header.offsets[s] % ALIGNMENT != 0 ||
+            header.offsets[s] < sizeof(Header) ||
+            header.offsets[s] > file.size() ||
+            size > file.size() - header.offsets[s]) {
+            return CacheStatus::CORRUPT;
+        }
+    }
+    auto section = [&](int s) { return file.data() + header.offsets[s]; };
+
+    Delaunator result;
+    result.m_points.resize(point_count);
+    if (point_count > 0) {
+        std::memcpy(result.m_points.ptrw(), section(SECTION_POINTS), header.sizes[SECTION_POINTS]);
+    }
+    if (!read_indices(section(SECTION_TRIANGLES), index_count, point_count, false, result.triangles) ||
+        !read_indices(section(SECTION_HALFEDGES), index_count, index_count, true, result.halfedges) ||
+        result.triangles.size() % 3 != 0) {
+        return CacheStatus::CORRUPT;
+    }
+    // Walks around a point go from halfedge to twin, so they only come back
+    // round if every twin is a different halfedge running back along the
+    // same edge, whose twin is the first.
+    for (std::size_t e = 0; e < index_count; e++) {
+        const std::size_t twin = result.halfedges[e];
+        if (twin == INVALID_INDEX) continue;
+        if (twin / 3 == e / 3 ||
+            result.halfedges[twin] != e ||
+            result.triangles[twin] != result.triangles[next_halfedge(e)] ||
+            result.triangles[next_halfedge(twin)] != result.triangles[e]) {
+            return CacheStatus::CORRUPT;
+        }
+    }
+
+    std::vector<std::size_t> hull;
+    std::vector<std::size_t> hull_tri;
+    if (!read_indices(section(SECTION_HULL), hull_size, point_count, false, hull) ||
+        // a hull from compute_hull() has no triangles to point into
+        !read_indices(section(SECTION_HULL_TRI), hull_size, index_count, hull_only, hull_tri)) {
+        return CacheStatus::CORRUPT;
+    }
+    if (hull_size > 0) {
+        result.hull_prev.assign(point_count, INVALID_INDEX);
+        result.hull_next.assign(point_count, INVALID_INDEX);
+        result.hull_tri.assign(point_count, INVALID_INDEX);
+        for (std::size_t k = 0; k < hull_size; k++) {
+            // a point twice over would leave the hull's links without a way
+            // back to its start, and each hull_tri is the edge to the next
+            const std::size_t next = hull[(k + 1) % hull_size];
+            if (result.hull_next[hull[k]] != INVALID_INDEX) return CacheStatus::CORRUPT;
+            result.hull_next[hull[k]] = next;
+            const std::size_t e = hull_tri[k];
+            if (e != INVALID_INDEX &&
+                (result.triangles[e] != hull[k] ||
+                 result.triangles[next_halfedge(e)] != next ||
+                 result.halfedges[e] != INVALID_INDEX)) {
+                return CacheStatus::CORRUPT;
+            }
+        }
+        for (std::size_t k = 0; k < hull_size; k++) {
+            const std::size_t next = hull[(k + 1) % hull_size];
+            result.hull_next[hull[k]] = next;
+            result.hull_prev[next] = hull[k];
+            result.hull_tri[hull[k]] = hull_tri[k];
+        }
+        result.hull_start = hull[0];
+    }
+
+    if (!read_indices(section(SECTION_SKIPPED), skipped_count, point_count, false, result.skipped)) {
+        return CacheStatus::CORRUPT;
+    }
+
+    CacheExtras loaded;
+    loaded.mode = static_cast<CacheMode>(header.mode);
+    loaded.tolerance = header.tolerance;
+    if (header.sizes[SECTION_POINT_REMAP] > 0 &&
+        !read_indices(section(SECTION_POINT_REMAP), point_count, point_count, false, loaded.point_remap)) {
+        return CacheStatus::CORRUPT;
+    }
+    if (header.sizes[SECTION_CIRCUMCENTERS] > 0) {
+        const godot::Vector2 *centers = reinterpret_cast<const godot::Vector2 *>(section(SECTION_CIRCUMCENTERS));
+        loaded.circumcenters.assign(centers, centers + index_count / 3);
+    }
+    if (header.sizes[SECTION_INEDGES] > 0) {
+        if (!read_indices(section(SECTION_INEDGES), point_count, index_count, true, loaded.inedges)) {
+            return CacheStatus::CORRUPT;
+        }
+        // each point's walk starts from a halfedge ending at it
+        for (std::size_t i = 0; i < point_count; i++) {
+            const std::size_t e = loaded.inedges[i];
+            if (e != INVALID_INDEX && result.triangles[next_halfedge(e)] != i) return CacheStatus::CORRUPT;
+        }
+    }
+    if (header.sizes[SECTION_WRAP_OFFSETS] > 0) {
+        const std::int8_t *offsets = reinterpret_cast<const std::int8_t *>(section(SECTION_WRAP_OFFSETS));
+        loaded.wrap_offsets.resize(index_count);
+        for (std::size_t i = 0; i < index_count; i++) {
+            loaded.wrap_offsets[i] = godot::Vector2i(offsets[2 * i], offsets[2 * i + 1]);
+        }
+    }
+    loaded.periodic_size = godot::Vector2(
+        static_cast<real_t>(header.periodic_size[0]),
+        static_cast<real_t>(header.periodic_size[1]));
+
+    delaunator = std::move(result);
+    extras = std::move(loaded);
+    return CacheStatus::OK;
+}
+
+} //namespace delaunator_cpp
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// Cache files hold a triangulation in a versioned binary layout: a fixed
+// header followed by sections of fixed-width arrays, each aligned to 16
+// bytes. Files are in the byte order of the machine that wrote them, which is
+// checked on load. Loading maps the file into memory and copies the
+// sections straight into the result, there's nothing to parse.
+constexpr std::uint32_t CACHE_VERSION = 2;
+
+// How the triangulation in a cache was made, so that it's only reused in
+// place of the same call.
+enum class CacheMode : std::uint32_t {
+    TRIANGULATION, // Delaunator.from(), with 'tolerance' its merge tolerance
+    HULL,          // Delaunator.compute_hull(): a hull and no triangles
+    PERIODIC       // Delaunator.from_periodic()
+};
+
+// Data stored with a triangulation: how it was made, the bindings' point
+// remap, and data derived from the triangulation. Empty vectors aren't
+// stored.
+struct CacheExtras {
+    CacheMode mode = CacheMode::TRIANGULATION;
+    double tolerance = 0.0;
+    std::vector<std::size_t> point_remap;
+    std::vector<godot::Vector2> circumcenters;
+    std::vector<std::size_t> inedges;
+    std::vector<godot::Vector2i> wrap_offsets;
+    godot::Vector2 periodic_size;
+};
+
+// What a cache's header says about it
+struct CacheInfo {
+    std::uint64_t points_hash = 0;
+    CacheMode mode = CacheMode::TRIANGULATION;
+    double tolerance = 0.0;
+};
+
+enum class CacheStatus {
+    OK,
+    CANT_OPEN,
+    CANT_WRITE,
+    UNRECOGNIZED, // not a cache file, or from another version / real_t size
+    CORRUPT
+};
+
+// A hash of the point coordinates, stored in the cache so it can be checked
+// against the points it's being loaded for.
+std::uint64_t hash_points(const godot::PackedVector2Array& points);
+
+CacheStatus save_triangulation(
+    const std::string& path,
+    const Delaunator& delaunator,
+    const CacheExtras& extras);
+
+// Reads only the header, giving the hash of the points the cache was made
+// from and how it was made.
+CacheStatus read_cache_info(const std::string& path, CacheInfo& info);
+
+// Checks the file's structure as well as its layout before using it: every
+// index is in range and every halfedge and its twin run opposite ways along
+// one edge, so a corrupt or crafted file can't send later walks astray. The
+// geometry isn't checked. delaunator.skipped is restored with the rest.
+CacheStatus load_triangulation(
+    const std::string& path,
+    Delaunator& delaunator,
+    CacheExtras& extras);
+
+} //namespace delaunator_cpp
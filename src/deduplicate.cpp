@@ -0,0 +1,170 @@
+#include "deduplicate.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace delaunator_cpp {
+
+namespace {
+
+inline std::uint64_t cell_key(std::int64_t x, std::int64_t y)
+{
+    // cells which share a key only cost extra comparisons
+    return (static_cast<std::uint64_t>(x) * 0x9E3779B97F4A7C15ull) ^ static_cast<std::uint64_t>(y);
+}
+
+// Cell indices are kept within this, so they fit in 64 bits with room for
+// the neighbouring cells
+constexpr double CELL_LIMIT = 4503599627370496.0; // 2^52
+
+// The cell a coordinate is in. Clamping keeps coordinates in neighbouring
+// cells in the same or neighbouring cells, and puts NaN in the lowest.
+inline std::int64_t cell_index(real_t value, double cell)
+{
+    const double index = std::floor(value / cell);
+    if (!(index >= -CELL_LIMIT)) return static_cast<std::int64_t>(-CELL_LIMIT);
+    if (index > CELL_LIMIT) return static_cast<std::int64_t>(CELL_LIMIT);
+    return static_cast<std::int64_t>(index);
+}
+
+// Equal coordinates hash equally, as std::hash does for 0.0 and -0.0
+struct CoordinateHash {
+    std::size_t operator()(const std::pair<real_t, real_t>& c) const
+    {
+        return std::hash<real_t>()(c.first) * 0x9E3779B97F4A7C15ull ^ std::hash<real_t>()(c.second);
+    }
+};
+
+inline double distance_squared(const godot::Vector2& a, const godot::Vector2& b)
+{
+    const double dx = static_cast<double>(a.x) - b.x;
+    const double dy = static_cast<double>(a.y) - b.y;
+    return dx * dx + dy * dy;
+}
+
+} // namespace
+
+std::vector<std::size_t> deduplicate(
+    const godot::PackedVector2Array& points,
+    double tolerance,
+    std::vector<std::size_t>& remap)
+{
+    const std::size_t n = points.size();
+    const godot::Vector2 *p = points.ptr();
+    remap.resize(n);
+    std::vector<std::size_t> kept;
+    if (n == 0) return kept;
+
+    // Without a tolerance only exact duplicates merge, which hashing the
+    // coordinates finds however the points are spread. NaN equals nothing,
+    // so those points are always kept.
+    if (!(tolerance > 0.0)) {
+        std::unordered_map<std::pair<real_t, real_t>, std::size_t, CoordinateHash> seen;
+        seen.reserve(n);
+        for (std::size_t i = 0; i < n; i++) {
+            if (std::isnan(p[i].x) || std::isnan(p[i].y)) {
+                remap[i] = i;
+                kept.push_back(i);
+                continue;
+            }
+            const auto inserted = seen.emplace(std::make_pair(p[i].x, p[i].y), i);
+            remap[i] = inserted.first->second;
+            if (inserted.second) kept.push_back(i);
+        }
+        return kept;
+    }
+
+    // the bounds of the finite points; the others are clamped into the
+    // outermost cells
+    godot::Vector2 min(0, 0);
+    godot::Vector2 max(0, 0);
+    bool first = true;
+    for (std::size_t i = 0; i < n; i++) {
+        if (!std::isfinite(p[i].x) || !std::isfinite(p[i].y)) continue;
+        min = first ? p[i] : godot::Vector2(std::min(min.x, p[i].x), std::min(min.y, p[i].y));
+        max = first ? p[i] : godot::Vector2(std::max(max.x, p[i].x), std::max(max.y, p[i].y));
+        first = false;
+    }
+
+    // With cells as wide as the tolerance, a point's matches are all in the
+    // 3x3 cells around it. A tolerance far below the coordinates would give
+    // more cells than there are indices; wider cells still hold every match
+    // in the 3x3 around a point, so they only cost comparisons.
+    const double largest = std::max(
+        std::max(std::abs(static_cast<double>(min.x)), std::abs(static_cast<double>(max.x))),
+        std::max(std::abs(static_cast<double>(min.y)), std::abs(static_cast<double>(max.y))));
+    double cell = tolerance;
+    if (largest / CELL_LIMIT > cell) cell = largest / CELL_LIMIT;
+    const double tolerance_squared = tolerance * tolerance;
+
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> grid;
+    grid.reserve(n);
+    for (std::size_t i = 0; i < n; i++) {
+        const std::int64_t cx = cell_index(p[i].x, cell);
+        const std::int64_t cy = cell_index(p[i].y, cell);
+
+        std::size_t match = INVALID_INDEX;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                const auto found = grid.find(cell_key(cx + dx, cy + dy));
+                if (found == grid.end()) continue;
+                for (std::size_t j : found->second) {
+                    if (j < match && distance_squared(p[i], p[j]) <= tolerance_squared) {
+                        match = j;
+                    }
+                }
+            }
+        }
+
+        if (match == INVALID_INDEX) {
+            remap[i] = i;
+            kept.push_back(i);
+            grid[cell_key(cx, cy)].push_back(i);
+        } else {
+            remap[i] = match;
+        }
+    }
+    return kept;
+}
+
+void remap_skipped(const Delaunator& delaunator, std::vector<std::size_t>& remap)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    std::size_t start = 0;
+
+    for (std::size_t i : delaunator.skipped) {
+        const godot::Vector2& p = delaunator.m_points[i];
+        std::size_t nearest = INVALID_INDEX;
+        double nearest_distance = (std::numeric_limits<double>::max)();
+        auto consider = [&](std::size_t j) {
+            const double d = distance_squared(p, delaunator.m_points[j]);
+            if (d < nearest_distance) {
+                nearest = j;
+                nearest_distance = d;
+            }
+        };
+
+        const std::size_t t = delaunator.locate(p, start);
+        if (t != INVALID_INDEX) {
+            start = t;
+            consider(triangles[3 * t]);
+            consider(triangles[3 * t + 1]);
+            consider(triangles[3 * t + 2]);
+        } else if (delaunator.hull_start != INVALID_INDEX) {
+            // just outside the hull, so a duplicate of a hull point
+            std::size_t e = delaunator.hull_start;
+            do {
+                consider(e);
+                e = delaunator.hull_next[e];
+            } while (e != delaunator.hull_start);
+        }
+        remap[i] = nearest;
+    }
+}
+
+} //namespace delaunator_cpp
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// Merges each point into the first earlier point within 'tolerance' of it,
+// comparing only points in neighbouring cells of a grid hash. When
+// tolerance is 0 only exact duplicates merge, found by hashing the
+// coordinates. remap receives, for each point, the
+// index of the point it was merged into, or its own index if it was kept.
+// Returns the indices of the kept points, in ascending order.
+std::vector<std::size_t> deduplicate(
+    const godot::PackedVector2Array& points,
+    double tolerance,
+    std::vector<std::size_t>& remap);
+
+// Points the sweep skipped (Delaunator::skipped) have no triangles; maps each
+// to the nearest corner of the triangle it lies in. remap must have an entry
+// for every point.
+void remap_skipped(const Delaunator& delaunator, std::vector<std::size_t>& remap);
+
+} //namespace delaunator_cpp
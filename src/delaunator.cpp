@@ -26,6 +26,8 @@
 // SOFTWARE.
 
 #include "delaunator.hpp"
+#include "delaunator_predicates.hpp"
+#include "validate.hpp"
 
 #include <iostream>
 
@@ -69,119 +71,6 @@ inline double dist(
     return dx * dx + dy * dy;
 }
 
-inline double circumradius(const godot::Vector2& p1, const godot::Vector2& p2, const godot::Vector2& p3)
-{
-    // calculating with Point instead of Vector2 here for double precision
-    Point d = Point(p2.x - p1.x, p2.y - p1.y);
-    Point e = Point(p3.x - p1.x, p3.y - p1.y);
-
-    const double bl = d.magnitude2();
-    const double cl = e.magnitude2();
-    const double det = Point::determinant(d, e);
-
-    Point radius((e.y() * bl - d.y() * cl) * 0.5 / det,
-                 (d.x() * cl - e.x() * bl) * 0.5 / det);
-
-    if ((bl > 0.0 || bl < 0.0) &&
-        (cl > 0.0 || cl < 0.0) &&
-        (det > 0.0 || det < 0.0))
-        return radius.magnitude2();
-    return (std::numeric_limits<double>::max)();
-}
-
-inline bool clockwise(const godot::Vector2& p0, const godot::Vector2& p1, const godot::Vector2& p2)
-{
-    godot::Vector2 v0 = p1 - p0;
-    godot::Vector2 v1 = p2 - p0;
-    real_t det = v0.cross(v1);
-    double dist = v0.length_squared() + v1.length_squared();
-    if (det == 0)
-        return false;
-    double reldet = std::abs(dist / det);
-    if (reldet > 1e14) // TODO: check this is still correct when the cross product was calculated in single precision
-        return false;
-    return det < 0;
-}
-
-inline bool clockwise(real_t px, real_t py, real_t qx, real_t qy, real_t rx, real_t ry)
-{
-    godot::Vector2 p0(px, py);
-    godot::Vector2 p1(qx, qy);
-    godot::Vector2 p2(rx, ry);
-
-    return clockwise(p0, p1, p2);
-}
-
-inline bool counterclockwise(const godot::Vector2& p0, const godot::Vector2& p1, const godot::Vector2& p2)
-{
-    godot::Vector2 v0 = p1 - p0;
-    godot::Vector2 v1 = p2 - p0;
-    real_t det = v0.cross(v1);
-    double dist = v0.length_squared() + v1.length_squared();
-    if (det == 0)
-        return false;
-    double reldet = std::abs(dist / det);
-    if (reldet > 1e14) // TODO: check this is still correct when the cross product was calculated in single precision
-        return false;
-    return det > 0;
-}
-
-inline bool counterclockwise(real_t px, real_t py, real_t qx, real_t qy, real_t rx, real_t ry)
-{
-    godot::Vector2 p0(px, py);
-    godot::Vector2 p1(qx, qy);
-    godot::Vector2 p2(rx, ry);
-
-    return counterclockwise(p0, p1, p2);
-}
-
-inline Point circumcenter(
-    const godot::Vector2& a,
-    const godot::Vector2& b,
-    const godot::Vector2& c) {
-
-    const double ax = static_cast<double>(a.x);
-    const double ay = static_cast<double>(a.y);
-    const double dx = b.x - ax;
-    const double dy = b.y - ay;
-    const double ex = c.x - ax;
-    const double ey = c.y - ay;
-
-    const double bl = dx * dx + dy * dy;
-    const double cl = ex * ex + ey * ey;
-    //ABELL - This is suspect for div-by-0.
-    const double d = dx * ey - dy * ex;
-
-    const double x = ax + (ey * bl - dy * cl) * 0.5 / d;
-    const double y = ay + (dx * cl - ex * bl) * 0.5 / d;
-
-    return Point(x, y);
-}
-
-inline bool in_circle(
-    const godot::Vector2& a,
-    const godot::Vector2& b,
-    const godot::Vector2& c,
-    const godot::Vector2& p) {
-
-    const double px = static_cast<double>(p.x);
-    const double py = static_cast<double>(p.y);
-    const double dx = a.x - px;
-    const double dy = a.y - py;
-    const double ex = b.x - px;
-    const double ey = b.y - py;
-    const double fx = c.x - px;
-    const double fy = c.y - py;
-
-    const double ap = dx * dx + dy * dy;
-    const double bp = ex * ex + ey * ey;
-    const double cp = fx * fx + fy * fy;
-
-    return (dx * (ey * cp - bp * fy) -
-            dy * (ex * cp - bp * fx) +
-            ap * (ex * fy - ey * fx)) < 0.0;
-}
-
 constexpr double EPSILON = std::numeric_limits<double>::epsilon();
 
 inline bool check_pts_equal(double x1, double y1, double x2, double y2) {
@@ -195,6 +84,19 @@ inline bool check_pts_equal(const godot::Vector2& p1, const godot::Vector2& p2)
 }
 
 
+// twice the signed area of [a, b, c] in double precision; triangles wind with
+// a negative area
+inline double orientation(const godot::Vector2& a, const godot::Vector2& b, const godot::Vector2& c) {
+    return (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y) -
+           (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - a.x);
+}
+
+inline std::vector<std::size_t> all_ids(std::size_t n) {
+    std::vector<std::size_t> ids(n);
+    std::iota(ids.begin(), ids.end(), 0);
+    return ids;
+}
+
 // monotonically increases with real angle, but doesn't need expensive trigonometry
 inline double pseudo_angle(const double dx, const double dy) {
     const double p = dx / (std::abs(dx) + std::abs(dy));
@@ -203,26 +105,26 @@ inline double pseudo_angle(const double dx, const double dy) {
 
 
 Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
+    : Delaunator(in_points, all_ids(in_points.size()))
+{}
+
+Delaunator::Delaunator(godot::PackedVector2Array const& in_points, std::vector<std::size_t> ids)
 {
     m_points = in_points; // take a copy to inc the refcount
                           // TODO: figure out if this leaks / figure out PackedVector2Array's ref counting implementation
     const std::size_t n = m_points.size();
 
-    std::vector<std::size_t> ids(n);
-    std::iota(ids.begin(), ids.end(), 0);
-
     real_t max_x =  std::numeric_limits<real_t>::lowest();
     real_t max_y =  std::numeric_limits<real_t>::lowest();
     real_t min_x = (std::numeric_limits<real_t>::max)();
     real_t min_y = (std::numeric_limits<real_t>::max)();
-    const godot::Vector2 *p = m_points.ptr();
-    for (int i = 0; i < n; i++) {
-        min_x = std::min(p->x, min_x);
-        min_y = std::min(p->y, min_y);
-        max_x = std::max(p->x, max_x);
-        max_y = std::max(p->y, max_y);
-        p++;
-    }    
+    for (const std::size_t i : ids) {
+        const godot::Vector2& p = m_points[i];
+        min_x = std::min(p.x, min_x);
+        min_y = std::min(p.y, min_y);
+        max_x = std::max(p.x, max_x);
+        max_y = std::max(p.y, max_y);
+    }
     double width = max_x - min_x;
     double height = max_y - min_y;
     double span = width * width + height * height; // Everything is square dist.
@@ -233,39 +135,48 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
     std::size_t i1 = INVALID_INDEX;
     std::size_t i2 = INVALID_INDEX;
 
-    // pick a seed point close to the centroid
-    real_t min_dist = (std::numeric_limits<real_t>::max)();
-    for (size_t i = 0; i < n; ++i)
+    // pick a seed point close to the centroid; distances are squared in
+    // double precision, as they overflow single precision for coordinates
+    // past 1e19
+    double min_dist = (std::numeric_limits<double>::max)();
+    for (const std::size_t i : ids)
     {
         const godot::Vector2& p = m_points[i];
-        const real_t d = center.distance_squared_to(p);
+        const double d = dist(p.x, p.y, center.x, center.y);
         if (d < min_dist) {
             i0 = i;
             min_dist = d;
         }
     }
 
+    if (i0 == INVALID_INDEX) { // no points
+        throw std::runtime_error("not triangulation");
+    }
     const godot::Vector2 *point_0 = &m_points[i0];
 
-    min_dist = (std::numeric_limits<real_t>::max)();
+    min_dist = (std::numeric_limits<double>::max)();
 
     // find the point closest to the seed
-    for (std::size_t i = 0; i < n; i++) {
+    for (const std::size_t i : ids) {
         if (i == i0) continue;
-        const real_t d = point_0->distance_squared_to(m_points[i]);
+        const double d = dist(point_0->x, point_0->y, m_points[i].x, m_points[i].y);
         if (d < min_dist && d > 0.0) {
             i1 = i;
             min_dist = d;
         }
     }
 
+    if (i1 == INVALID_INDEX) { // every point is the same
+        throw std::runtime_error("not triangulation");
+    }
+
     const godot::Vector2 *point_1 = &m_points[i1];
 
     double min_radius = (std::numeric_limits<double>::max)();
 
     // find the third point which forms the smallest circumcircle
     // with the first two
-    for (std::size_t i = 0; i < n; i++) {
+    for (const std::size_t i : ids) {
         if (i == i0 || i == i1) continue;
 
         const double r = circumradius(*point_0, *point_1, m_points[i]);
@@ -275,13 +186,29 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
         }
     }
 
-    if (!(min_radius < (std::numeric_limits<double>::max)())) {
+    // The radii are rounded, so they can miss or invent a seed triangle when
+    // the points are nearly collinear. The exact test decides, so the points
+    // only have no triangulation when exactly_collinear() says so.
+    if (!(min_radius < (std::numeric_limits<double>::max)()) ||
+        exact_orientation(*point_0, *point_1, m_points[i2]) == 0) {
+        i2 = INVALID_INDEX;
+        for (const std::size_t i : ids) {
+            if (exact_orientation(*point_0, *point_1, m_points[i]) != 0) {
+                i2 = i;
+                break;
+            }
+        }
+    }
+
+    if (i2 == INVALID_INDEX) { // every point is on one line
         throw std::runtime_error("not triangulation");
     }
 
     const godot::Vector2 *point_2 = &m_points[i2];
 
-    if (counterclockwise(*point_0, *point_1, *point_2)) {
+    // exactly, as counterclockwise() can't tell for a thin seed triangle,
+    // and every later triangle takes its winding from this one
+    if (exact_orientation(*point_0, *point_1, *point_2) > 0) {
         std::swap(i1, i2);
         std::swap(point_1, point_2);
     }
@@ -293,13 +220,10 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
     // but GCC 7.5+ would copy the comparator to iterators used in the
     // sort, and this was excruciatingly slow when there were many points
     // because you had to copy the vector of distances.
-    std::vector<double> dists;
-    dists.reserve(m_points.size());
-    p = m_points.ptr();
-    for (int i = 0; i < n; i++) {
-        dists.push_back(dist(p->x, p->y, m_center.x(), m_center.y()));
-        p++;
-    }    
+    std::vector<double> dists(n);
+    for (const std::size_t i : ids) {
+        dists[i] = dist(m_points[i].x, m_points[i].y, m_center.x(), m_center.y());
+    }
 
 
     // sort the points by distance from the seed triangle circumcenter
@@ -308,14 +232,15 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
             { return dists[i] < dists[j]; });
 
     // initialize a hash table for storing edges of the advancing convex hull
-    m_hash_size = static_cast<std::size_t>(std::ceil(std::sqrt(n)));
+    m_hash_size = static_cast<std::size_t>(std::ceil(std::sqrt(ids.size())));
     m_hash.resize(m_hash_size);
     std::fill(m_hash.begin(), m_hash.end(), INVALID_INDEX);
 
-    // initialize arrays for tracking the edges of the advancing convex hull
-    hull_prev.resize(n);
-    hull_next.resize(n);
-    hull_tri.resize(n);
+    // initialize arrays for tracking the edges of the advancing convex hull;
+    // points which aren't triangulated keep INVALID_INDEX
+    hull_prev.assign(n, INVALID_INDEX);
+    hull_next.assign(n, INVALID_INDEX);
+    hull_tri.assign(n, INVALID_INDEX);
 
     hull_start = i0;
 
@@ -336,25 +261,31 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
     // ABELL - Why are we doing this is n < 3?  There is no triangulation if
     //  there is no triangle.
 
-    std::size_t max_triangles = n < 3 ? 1 : 2 * n - 5;
+    std::size_t max_triangles = ids.size() < 3 ? 1 : 2 * ids.size() - 5;
     triangles.reserve(max_triangles * 3);
     halfedges.reserve(max_triangles * 3);
     add_triangle(i0, i1, i2, INVALID_INDEX, INVALID_INDEX, INVALID_INDEX);
     godot::Vector2 point_prev(std::numeric_limits<real_t>::quiet_NaN(), std::numeric_limits<real_t>::quiet_NaN());
 
     // Go through points based on distance from the center.
-    for (std::size_t k = 0; k < n; k++) {
+    for (std::size_t k = 0; k < ids.size(); k++) {
         const std::size_t i = ids[k];
         const godot::Vector2& point_i = m_points[i];
 
+        // skip seed triangle points, which are already triangulated even
+        // when they duplicate the point before
+        if (i == i0 || i == i1 || i == i2) {
+            point_prev = point_i;
+            continue;
+        }
+
         // skip near-duplicate points
-        if (k > 0 && check_pts_equal(point_i, point_prev))
+        if (k > 0 && check_pts_equal(point_i, point_prev)) {
+            skipped.push_back(i);
             continue;
+        }
         point_prev = point_i;
 
-        // skip seed triangle points
-        if (i == i0 || i == i1 || i == i2) continue;
-
         // find a visible edge on the convex hull using edge hash
         std::size_t start = 0;
 
@@ -377,6 +308,7 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
         start = hull_prev[start];
         size_t e = start;
         size_t q;
+        bool duplicate = false;
 
         // Advance until we find a place in the hull where our current point
         // can be added.
@@ -387,9 +319,10 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
                 Point::equal(m_points[i], m_points[q], span))
             {
                 e = INVALID_INDEX;
+                duplicate = true;
                 break;
             }
-            if (counterclockwise(point_i, m_points[e], m_points[q]))
+            if (exact_orientation(point_i, m_points[e], m_points[q]) > 0)
                 break;
             e = q;
             if (e == start) {
@@ -398,10 +331,15 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
             }
         }
 
-        // ABELL
-        // This seems wrong.  Perhaps we should check what's going on?
-        if (e == INVALID_INDEX)     // likely a near-duplicate point; skip it
+        // No hull edge faces the point. Points sorted by distance from the
+        // seed's circumcenter are each outside the hull so far, but nearly
+        // collinear points have a huge seed circle whose rounded center can
+        // put one inside it, which is added by splitting the triangle (or
+        // edge) it's in.
+        if (e == INVALID_INDEX) {
+            if (duplicate || !insert_inside(i)) skipped.push_back(i);
             continue;
+        }
 
         // add the first triangle from the point
         std::size_t t = add_triangle(
@@ -422,7 +360,7 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
         while (true)
         {
             q = hull_next[next];
-            if (!counterclockwise(point_i, m_points[next], m_points[q]))
+            if (exact_orientation(point_i, m_points[next], m_points[q]) <= 0)
                 break;
             t = add_triangle(next, i, q,
                 hull_tri[i], INVALID_INDEX, hull_tri[next]);
@@ -437,7 +375,7 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
             while (true)
             {
                 q = hull_prev[e];
-                if (!counterclockwise(point_i, m_points[q], m_points[e]))
+                if (exact_orientation(point_i, m_points[q], m_points[e]) <= 0)
                     break;
                 t = add_triangle(q, i, e,
                     INVALID_INDEX, hull_tri[e], hull_tri[q]);
@@ -459,11 +397,18 @@ Delaunator::Delaunator(godot::PackedVector2Array const& in_points)
         m_hash[key] = i;
         m_hash[hash_key(m_points[e])] = e;
     }
+    std::sort(skipped.begin(), skipped.end());
 }
 
+Delaunator::Delaunator()
+    : hull_start(INVALID_INDEX), m_hash_size(0)
+{}
+
 // Returns twice the hull area, divide by two for actual area.
-double Delaunator::get_hull_area()
+double Delaunator::get_hull_area() const
 {
+    if (hull_start == INVALID_INDEX) return 0.0;
+
     std::vector<double> hull_area;
     size_t e = hull_start;
     do {
@@ -480,7 +425,7 @@ double Delaunator::get_hull_area()
 // Returns twice the triangle area, divide by two for actual area.
 // Was used by unit test to check get_hull_area(), so
 // doesn't have to be optimized.
-double Delaunator::get_triangle_area()
+double Delaunator::get_triangle_area() const
 {    
     std::vector<double> vals;
     for (size_t i = 0; i < triangles.size(); i += 3)
@@ -497,6 +442,407 @@ double Delaunator::get_triangle_area()
     return sum(vals);
 }
 
+std::size_t Delaunator::locate(const godot::Vector2& p, std::size_t start) const
+{
+    const std::size_t triangle_count = triangles.size() / 3;
+    if (triangle_count == 0) return INVALID_INDEX;
+
+    // p is beyond the edge a->b when the cross product is positive, as the
+    // triangles all have a negative winding
+    auto beyond = [&](std::size_t e) {
+        const godot::Vector2& a = m_points[triangles[e]];
+        const godot::Vector2& b = m_points[triangles[next_halfedge(e)]];
+        const double det =
+            (static_cast<double>(b.x) - a.x) * (static_cast<double>(p.y) - a.y) -
+            (static_cast<double>(b.y) - a.y) * (static_cast<double>(p.x) - a.x);
+        return det > 0.0;
+    };
+
+    std::size_t t = start < triangle_count ? start : 0;
+    for (std::size_t step = 0; step < triangle_count; step++) {
+        std::size_t e_beyond = INVALID_INDEX;
+
+        // rotate which edge is checked first so near-degenerate triangles
+        // can't trap the walk in a cycle
+        for (std::size_t k = 0; k < 3; k++) {
+            const std::size_t e = 3 * t + (k + step) % 3;
+            if (beyond(e)) {
+                e_beyond = e;
+                break;
+            }
+        }
+        if (e_beyond == INVALID_INDEX) return t;
+
+        // beyond a hull edge means outside the (convex) hull
+        if (halfedges[e_beyond] == INVALID_INDEX) return INVALID_INDEX;
+        t = halfedges[e_beyond] / 3;
+    }
+
+    // the walk didn't converge, fall back to checking every triangle
+    for (t = 0; t < triangle_count; t++) {
+        if (!beyond(3 * t) && !beyond(3 * t + 1) && !beyond(3 * t + 2)) return t;
+    }
+    return INVALID_INDEX;
+}
+
+bool Delaunator::update_positions(godot::PackedVector2Array const& in_coords, double max_flip_fraction)
+{
+    // checked first, as the rebuild would throw after the repair had
+    // already moved things; this usually stops at the third point
+    if (exactly_collinear(in_coords)) {
+        throw std::runtime_error("not triangulation");
+    }
+
+    const std::size_t n = in_coords.size();
+    const std::size_t triangle_count = triangles.size() / 3;
+    bool repairable = n == static_cast<std::size_t>(m_points.size()) &&
+                      triangle_count > 0 &&
+                      hull_start != INVALID_INDEX;
+
+    if (repairable) {
+        // a triangulation of n points with h on the hull has 2n - h - 2
+        // triangles, fewer means some points weren't triangulated
+        std::size_t hull_size = 0;
+        std::size_t e = hull_start;
+        do {
+            hull_size++;
+            e = hull_next[e];
+        } while (e != hull_start);
+        repairable = triangle_count + hull_size + 2 == 2 * n;
+    }
+
+    // Move the points in steps, repairing after each. A thin triangle can
+    // invert during a move that would have flipped it away partway through,
+    // so when a step inverts a triangle that can't be repaired, it's retried
+    // at half the size.
+    constexpr double MIN_STEP = 1.0 / 16.0;
+    const godot::PackedVector2Array start = m_points;
+    const std::size_t max_flips = static_cast<std::size_t>(max_flip_fraction * triangle_count);
+    m_flip_count = 0;
+
+    double done = 0.0;
+    double step = 1.0;
+    while (repairable && done < 1.0) {
+        const double next = std::min(1.0, done + step);
+        if (next == 1.0) {
+            m_points = in_coords;
+        } else {
+            godot::Vector2 *p = m_points.ptrw();
+            for (std::size_t i = 0; i < n; i++) {
+                p[i] = start[i] + (in_coords[i] - start[i]) * static_cast<real_t>(next);
+            }
+        }
+
+        if (!untangle(max_flips)) {
+            step *= 0.5;
+            repairable = step >= MIN_STEP;
+            continue;
+        }
+
+        // hull points may have moved inwards
+        fill_hull_notches();
+
+        repairable = restore_delaunay(max_flips);
+        done = next;
+    }
+
+    if (!repairable) {
+        *this = Delaunator(in_coords);
+    }
+    return repairable;
+}
+
+template <typename Illegal>
+bool Delaunator::lawson_flips(const Illegal& illegal, std::size_t max_flips)
+{
+    // Lawson's flip algorithm: flip every edge that fails the in-circle test,
+    // and recheck the four edges around each flipped one. legalize() only
+    // rechecks the edges a new point in the sweep can't be on.
+    m_edge_stack.clear();
+    for (std::size_t e = 0; e < halfedges.size(); e++) {
+        if (halfedges[e] != INVALID_INDEX && halfedges[e] > e) m_edge_stack.push_back(e);
+    }
+    return flip_stacked_edges(illegal, max_flips);
+}
+
+template <typename Illegal>
+bool Delaunator::flip_stacked_edges(const Illegal& illegal, std::size_t max_flips)
+{
+    while (!m_edge_stack.empty()) {
+        const std::size_t a = m_edge_stack.back();
+        m_edge_stack.pop_back();
+        const std::size_t b = halfedges[a];
+        if (b == INVALID_INDEX) continue;
+        if (!illegal(a)) continue;
+
+        if (++m_flip_count > max_flips) return false;
+        const std::size_t al = next_halfedge(a);
+        flip_inside_hull(a);
+        m_edge_stack.push_back(a);
+        m_edge_stack.push_back(al);
+        m_edge_stack.push_back(b);
+        m_edge_stack.push_back(next_halfedge(b));
+    }
+    return true;
+}
+
+bool Delaunator::illegal(std::size_t a) const
+{
+    return exact_in_circle(
+        m_points[triangles[prev_halfedge(a)]],
+        m_points[triangles[a]],
+        m_points[triangles[next_halfedge(a)]],
+        m_points[triangles[prev_halfedge(halfedges[a])]]) < 0;
+}
+
+bool Delaunator::restore_delaunay(std::size_t max_flips)
+{
+    return lawson_flips([this](std::size_t a) { return illegal(a); }, max_flips);
+}
+
+bool Delaunator::insert_inside(std::size_t i)
+{
+    const godot::Vector2& p = m_points[i];
+    const std::size_t triangle_count = triangles.size() / 3;
+
+    // locate() rounds, so it can stop a step short of the triangle p is
+    // in; the walk is finished exactly, with a scan in case it cycles
+    auto beyond = [&](std::size_t e) {
+        return exact_orientation(m_points[triangles[e]], m_points[triangles[next_halfedge(e)]], p) > 0;
+    };
+    std::size_t t = locate(p, hull_tri[hull_start] / 3);
+    if (t == INVALID_INDEX) t = hull_tri[hull_start] / 3;
+    for (std::size_t step = 0;; step++) {
+        std::size_t e_beyond = INVALID_INDEX;
+        for (std::size_t k = 0; k < 3 && e_beyond == INVALID_INDEX; k++) {
+            if (beyond(3 * t + (k + step) % 3)) e_beyond = 3 * t + (k + step) % 3;
+        }
+        if (e_beyond == INVALID_INDEX) break;
+        if (halfedges[e_beyond] == INVALID_INDEX || step == triangle_count) {
+            t = INVALID_INDEX;
+            for (std::size_t u = 0; u < triangle_count && t == INVALID_INDEX; u++) {
+                if (!beyond(3 * u) && !beyond(3 * u + 1) && !beyond(3 * u + 2)) t = u;
+            }
+            break;
+        }
+        t = halfedges[e_beyond] / 3;
+    }
+    if (t == INVALID_INDEX) return false;
+
+    // the edge p is on, if any
+    std::size_t h = INVALID_INDEX;
+    for (std::size_t e = 3 * t; e < 3 * t + 3; e++) {
+        if (check_pts_equal(p, m_points[triangles[e]])) return false;
+        if (exact_orientation(m_points[triangles[e]], m_points[triangles[next_halfedge(e)]], p) == 0) h = e;
+    }
+
+    m_edge_stack.clear();
+    if (h == INVALID_INDEX) {
+        // split [a, b, c] into [a, b, p], [b, c, p] and [c, a, p]
+        const std::size_t e0 = 3 * t;
+        const std::size_t a = triangles[e0];
+        const std::size_t b = triangles[e0 + 1];
+        const std::size_t c = triangles[e0 + 2];
+        const std::size_t bc = halfedges[e0 + 1];
+        const std::size_t ca = halfedges[e0 + 2];
+        triangles[e0 + 2] = i;
+        const std::size_t t1 = add_triangle(b, c, i, bc, INVALID_INDEX, e0 + 1);
+        const std::size_t t2 = add_triangle(c, a, i, ca, e0 + 2, t1 + 1);
+        if (bc == INVALID_INDEX) hull_tri[b] = t1;
+        if (ca == INVALID_INDEX) hull_tri[c] = t2;
+        m_edge_stack.push_back(e0);
+        m_edge_stack.push_back(t1);
+        m_edge_stack.push_back(t2);
+    } else {
+        // split [x, y, z] at p on x->y into [x, p, z] and [p, y, z], and
+        // the triangle across the edge the same way
+        const std::size_t g = halfedges[h];
+        const std::size_t x = triangles[h];
+        const std::size_t y = triangles[next_halfedge(h)];
+        const std::size_t z = triangles[prev_halfedge(h)];
+        const std::size_t yz = halfedges[next_halfedge(h)];
+        triangles[next_halfedge(h)] = i;
+        const std::size_t t1 = add_triangle(i, y, z, g, yz, next_halfedge(h));
+        if (yz == INVALID_INDEX) hull_tri[y] = t1 + 1;
+        m_edge_stack.push_back(prev_halfedge(h));
+        m_edge_stack.push_back(t1 + 1);
+
+        if (g == INVALID_INDEX) {
+            // p joins the hull between x and y
+            hull_next[x] = i;
+            hull_prev[i] = x;
+            hull_next[i] = y;
+            hull_prev[y] = i;
+            hull_tri[x] = h;
+            hull_tri[i] = t1;
+        } else {
+            // [y, x, w] becomes [y, p, w] and [p, x, w]
+            const std::size_t w = triangles[prev_halfedge(g)];
+            const std::size_t xw = halfedges[next_halfedge(g)];
+            triangles[next_halfedge(g)] = i;
+            const std::size_t u1 = add_triangle(i, x, w, h, xw, next_halfedge(g));
+            link(g, t1);
+            if (xw == INVALID_INDEX) hull_tri[x] = u1 + 1;
+            m_edge_stack.push_back(prev_halfedge(g));
+            m_edge_stack.push_back(u1 + 1);
+        }
+    }
+    flip_stacked_edges([this](std::size_t a) { return illegal(a); }, (std::numeric_limits<std::size_t>::max)());
+    return true;
+}
+
+bool Delaunator::restore_delaunay(const std::function<bool(std::size_t)>& illegal, std::size_t max_flips)
+{
+    m_flip_count = 0;
+    return lawson_flips(illegal, max_flips);
+}
+
+bool Delaunator::untangle(std::size_t max_flips)
+{
+    // flat triangles count too: a point which has landed exactly on the
+    // opposite edge has to be walked off it just the same
+    auto is_inverted = [&](std::size_t e0) {
+        return orientation(m_points[triangles[e0]], m_points[triangles[e0 + 1]], m_points[triangles[e0 + 2]]) >= 0.0;
+    };
+
+    std::vector<bool> on_hull;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        bool inverted = false;
+
+        for (std::size_t e0 = 0; e0 < triangles.size();) {
+            if (!is_inverted(e0)) {
+                e0 += 3;
+                continue;
+            }
+            inverted = true;
+
+            // A point that has crossed the opposite edge is the one nearest
+            // it, so that's the longest edge.
+            std::size_t h = e0;
+            double longest = 0.0;
+            for (std::size_t k = 0; k < 3; k++) {
+                const double l = m_points[triangles[e0 + k]].distance_squared_to(m_points[triangles[next_halfedge(e0 + k)]]);
+                if (l > longest) {
+                    longest = l;
+                    h = e0 + k;
+                }
+            }
+            const std::size_t a = triangles[h];
+            const std::size_t b = triangles[next_halfedge(h)];
+            const std::size_t c = triangles[prev_halfedge(h)];
+
+            if (halfedges[h] == INVALID_INDEX) {
+                // c has crossed a hull edge and joins the hull
+                if (on_hull.empty()) {
+                    on_hull.assign(m_points.size(), false);
+                    std::size_t e = hull_start;
+                    do {
+                        on_hull[e] = true;
+                        e = hull_next[e];
+                    } while (e != hull_start);
+                }
+                const std::size_t to_b = halfedges[next_halfedge(h)];
+                const std::size_t from_a = halfedges[prev_halfedge(h)];
+                if (on_hull[c] || to_b == INVALID_INDEX || from_a == INVALID_INDEX) {
+                    e0 += 3;
+                    continue;
+                }
+
+                halfedges[to_b] = INVALID_INDEX;
+                halfedges[from_a] = INVALID_INDEX;
+                hull_next[a] = c;
+                hull_prev[c] = a;
+                hull_next[c] = b;
+                hull_prev[b] = c;
+                hull_tri[a] = from_a;
+                hull_tri[c] = to_b;
+                on_hull[c] = true;
+                remove_triangle(e0 / 3); // moves another triangle to e0
+            } else {
+                // c has crossed into the neighboring triangle, and flipping
+                // the edge splits that triangle at c. If c has gone past it,
+                // one of the new triangles is still inverted and is flipped
+                // in turn, walking c through to where it is now.
+                const std::size_t d = triangles[prev_halfedge(halfedges[h])];
+                if (orientation(m_points[d], m_points[b], m_points[c]) >= 0.0 &&
+                    orientation(m_points[c], m_points[a], m_points[d]) >= 0.0) {
+                    e0 += 3;
+                    continue;
+                }
+                flip_inside_hull(h);
+                e0 += 3;
+            }
+            if (++m_flip_count > max_flips) return false;
+            changed = true;
+        }
+
+        if (!inverted) return true;
+    }
+    return false;
+}
+
+void Delaunator::remove_triangle(std::size_t t)
+{
+    // move the last triangle into t's place
+    const std::size_t last = triangles.size() / 3 - 1;
+    if (t != last) {
+        for (std::size_t k = 0; k < 3; k++) {
+            const std::size_t from = 3 * last + k;
+            const std::size_t to = 3 * t + k;
+            triangles[to] = triangles[from];
+            halfedges[to] = halfedges[from];
+            if (halfedges[to] != INVALID_INDEX) {
+                halfedges[halfedges[to]] = to;
+            } else {
+                hull_tri[triangles[to]] = to;
+            }
+        }
+    }
+    triangles.resize(3 * last);
+    halfedges.resize(3 * last);
+}
+
+void Delaunator::fill_hull_notches()
+{
+    // A hull point that has moved inwards leaves a notch in the hull, which
+    // is filled by a triangle joining its neighbors - as the sweep does when
+    // it walks around the hull from a new point.
+    std::size_t e = hull_start;
+    std::size_t unchanged = 0;
+    std::size_t hull_size = 0;
+    do {
+        hull_size++;
+        e = hull_next[e];
+    } while (e != hull_start);
+
+    while (unchanged < hull_size && hull_size > 3) {
+        const std::size_t prev = hull_prev[e];
+        const std::size_t next = hull_next[e];
+        const godot::Vector2& a = m_points[prev];
+        const godot::Vector2& b = m_points[e];
+        const godot::Vector2& c = m_points[next];
+        if (orientation(a, b, c) <= 0.0) {
+            unchanged++;
+            e = next;
+            continue;
+        }
+
+        const std::size_t t = add_triangle(e, prev, next, hull_tri[prev], INVALID_INDEX, hull_tri[e]);
+        hull_tri[prev] = t + 1;
+        hull_next[prev] = next;
+        hull_prev[next] = prev;
+        hull_next[e] = e; // mark as removed
+        if (hull_start == e) hull_start = prev;
+        hull_size--;
+
+        // the notch may have made its neighbor a notch too
+        unchanged = 0;
+        e = prev;
+    }
+}
+
 std::size_t Delaunator::legalize(std::size_t a) {
     std::size_t i = 0;
     std::size_t ar = 0;
@@ -544,33 +890,14 @@ std::size_t Delaunator::legalize(std::size_t a) {
         const std::size_t pl = triangles[al];
         const std::size_t p1 = triangles[bl];
 
-        const bool illegal = in_circle(
+        const bool illegal = exact_in_circle(
             m_points[p0],
             m_points[pr],
             m_points[pl],
-            m_points[p1]); // WARNING: pl and p1 are different!
+            m_points[p1]) < 0; // WARNING: pl and p1 are different!
 
         if (illegal) {
-            triangles[a] = p1;
-            triangles[b] = p0;
-
-            auto hbl = halfedges[bl];
-
-            // Edge swapped on the other side of the hull (rare).
-            // Fix the halfedge reference
-            if (hbl == INVALID_INDEX) {
-                std::size_t e = hull_start;
-                do {
-                    if (hull_tri[e] == bl) {
-                        hull_tri[e] = a;
-                        break;
-                    }
-                    e = hull_prev[e];
-                } while (e != hull_start);
-            }
-            link(a, hbl);
-            link(b, halfedges[ar]);
-            link(ar, bl);
+            flip(a);
             std::size_t br = b0 + (b + 1) % 3;
 
             if (i < m_edge_stack.size()) {
@@ -593,6 +920,46 @@ std::size_t Delaunator::legalize(std::size_t a) {
     return ar;
 }
 
+void Delaunator::flip(std::size_t a) {
+    // see the diagram in legalize()
+    const std::size_t b = halfedges[a];
+    const std::size_t a0 = 3 * (a / 3);
+    const std::size_t b0 = 3 * (b / 3);
+    const std::size_t ar = a0 + (a + 2) % 3;
+    const std::size_t bl = b0 + (b + 2) % 3;
+
+    triangles[a] = triangles[bl];
+    triangles[b] = triangles[ar];
+
+    auto hbl = halfedges[bl];
+
+    // Edge swapped on the other side of the hull (rare).
+    // Fix the halfedge reference
+    if (hbl == INVALID_INDEX) {
+        std::size_t e = hull_start;
+        do {
+            if (hull_tri[e] == bl) {
+                hull_tri[e] = a;
+                break;
+            }
+            e = hull_prev[e];
+        } while (e != hull_start);
+    }
+    link(a, hbl);
+    link(b, halfedges[ar]);
+    link(ar, bl);
+}
+
+void Delaunator::flip_inside_hull(std::size_t a) {
+    // In the sweep, legalize() returns ar so the caller can fix up the hull
+    // when it's a hull edge; here the hull is already complete.
+    const std::size_t ar = prev_halfedge(a);
+    if (halfedges[ar] == INVALID_INDEX) {
+        hull_tri[triangles[ar]] = halfedges[a];
+    }
+    flip(a);
+}
+
 std::size_t Delaunator::hash_key(const godot::Vector2& p) const {
     const double dx = p.x - m_center.x();
     const double dy = p.y - m_center.y();
@@ -32,6 +32,7 @@
 #define INLINE
 #endif
 
+#include <functional>
 #include <limits>
 #include <vector>
 #include <ostream>
@@ -44,6 +45,13 @@ namespace delaunator_cpp {
 constexpr std::size_t INVALID_INDEX =
     (std::numeric_limits<std::size_t>::max)();
 
+// The next/previous halfedge within the same triangle.
+inline std::size_t next_halfedge(std::size_t e)
+{ return (e % 3 == 2) ? e - 2 : e + 1; }
+
+inline std::size_t prev_halfedge(std::size_t e)
+{ return (e % 3 == 0) ? e + 2 : e - 1; }
+
 class Point
 {
 public:
@@ -92,7 +100,7 @@ public:
 
         // ABELL - This number should be examined to figure how how
         // it correlates with the breakdown of calculating determinants.
-        return dist < CMP_EPSILON;
+        return dist < 1e-20;
     }
 
 private:
@@ -130,17 +138,69 @@ public:
     std::vector<std::size_t> hull_tri;
     std::size_t hull_start;
 
+    // Points the sweep left out as (near-)duplicates of triangulated points,
+    // in ascending order. They appear in no triangle and their hull entries
+    // are INVALID_INDEX.
+    std::vector<std::size_t> skipped;
+
+    // Throws std::runtime_error if the points all lie on one line (which
+    // includes there being fewer than three different points).
     INLINE Delaunator(godot::PackedVector2Array const& in_coords);
-    INLINE double get_hull_area();
-    INLINE double get_triangle_area();
+    // Triangulates only the points listed in ids; the others are left out
+    // as if skipped, but aren't listed in 'skipped'.
+    INLINE Delaunator(godot::PackedVector2Array const& in_coords, std::vector<std::size_t> ids);
+
+    // An empty triangulation (without a hull), for results that are
+    // assembled rather than swept
+    INLINE Delaunator();
+    INLINE double get_hull_area() const;
+    INLINE double get_triangle_area() const;
+
+    // Returns the index of the triangle containing p (its first halfedge
+    // divided by 3), or INVALID_INDEX if p is outside the hull. The walk
+    // starts from triangle 'start', so locating a run of nearby points is
+    // cheapest when each search starts from the previous result.
+    INLINE std::size_t locate(const godot::Vector2& p, std::size_t start = 0) const;
+
+    // Moves the points to new positions (in_coords must have the same
+    // number of points), keeping the topology and repairing it with edge
+    // flips, and by adding/removing triangles at the hull as points join or
+    // leave it. Falls back to triangulating from scratch when it can't be
+    // repaired (triangles stayed inverted at the smallest step, or the
+    // previous sweep skipped points), or when more than
+    // max_flip_fraction * triangle count repairs are needed.
+    // Returns true if the triangulation was repaired rather than rebuilt.
+    // Throws std::runtime_error, leaving the triangulation as it was, if the
+    // points all lie on one line, as the constructor would.
+    INLINE bool update_positions(godot::PackedVector2Array const& in_coords, double max_flip_fraction);
+
+    // Lawson's flip algorithm with the caller's in-circle test, for results
+    // whose points need a different one from the sweep's: flips the edge of
+    // each interior halfedge a for which illegal(a) holds until none does.
+    // Returns false, leaving a valid but unfinished triangulation, if that
+    // takes more than max_flips flips.
+    INLINE bool restore_delaunay(const std::function<bool(std::size_t)>& illegal, std::size_t max_flips);
 
 private:
     std::vector<std::size_t> m_hash;
     Point m_center;
     std::size_t m_hash_size;
     std::vector<std::size_t> m_edge_stack;
+    std::size_t m_flip_count = 0;
 
     INLINE std::size_t legalize(std::size_t a);
+    INLINE void flip(std::size_t a);
+    INLINE void flip_inside_hull(std::size_t a);
+    INLINE bool untangle(std::size_t max_flips);
+    INLINE bool restore_delaunay(std::size_t max_flips);
+    template <typename Illegal>
+    bool lawson_flips(const Illegal& illegal, std::size_t max_flips);
+    template <typename Illegal>
+    bool flip_stacked_edges(const Illegal& illegal, std::size_t max_flips);
+    INLINE bool illegal(std::size_t a) const;
+    INLINE bool insert_inside(std::size_t i);
+    INLINE void remove_triangle(std::size_t t);
+    INLINE void fill_hull_notches();
     INLINE std::size_t hash_key(const godot::Vector2& p) const;
 
     INLINE std::size_t add_triangle(
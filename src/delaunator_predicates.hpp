@@ -0,0 +1,129 @@
+// Geometric predicates shared by the triangulation and the algorithms built on
+// its output, split out of delaunator.cpp (delaunator-cpp, MIT License, see
+// delaunator.cpp for the full notice).
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include <godot_cpp/variant/vector2.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+inline double circumradius(const godot::Vector2& p1, const godot::Vector2& p2, const godot::Vector2& p3)
+{
+    // calculating with Point instead of Vector2 here for double precision
+    Point d = Point(p2.x - p1.x, p2.y - p1.y);
+    Point e = Point(p3.x - p1.x, p3.y - p1.y);
+
+    const double bl = d.magnitude2();
+    const double cl = e.magnitude2();
+    const double det = Point::determinant(d, e);
+
+    Point radius((e.y() * bl - d.y() * cl) * 0.5 / det,
+                 (d.x() * cl - e.x() * bl) * 0.5 / det);
+
+    if ((bl > 0.0 || bl < 0.0) &&
+        (cl > 0.0 || cl < 0.0) &&
+        (det > 0.0 || det < 0.0))
+        return radius.magnitude2();
+    return (std::numeric_limits<double>::max)();
+}
+
+inline bool clockwise(const godot::Vector2& p0, const godot::Vector2& p1, const godot::Vector2& p2)
+{
+    godot::Vector2 v0 = p1 - p0;
+    godot::Vector2 v1 = p2 - p0;
+    real_t det = v0.cross(v1);
+    double dist = v0.length_squared() + v1.length_squared();
+    if (det == 0)
+        return false;
+    double reldet = std::abs(dist / det);
+    if (reldet > 1e14) // TODO: check this is still correct when the cross product was calculated in single precision
+        return false;
+    return det < 0;
+}
+
+inline bool clockwise(real_t px, real_t py, real_t qx, real_t qy, real_t rx, real_t ry)
+{
+    godot::Vector2 p0(px, py);
+    godot::Vector2 p1(qx, qy);
+    godot::Vector2 p2(rx, ry);
+
+    return clockwise(p0, p1, p2);
+}
+
+inline bool counterclockwise(const godot::Vector2& p0, const godot::Vector2& p1, const godot::Vector2& p2)
+{
+    godot::Vector2 v0 = p1 - p0;
+    godot::Vector2 v1 = p2 - p0;
+    real_t det = v0.cross(v1);
+    double dist = v0.length_squared() + v1.length_squared();
+    if (det == 0)
+        return false;
+    double reldet = std::abs(dist / det);
+    if (reldet > 1e14) // TODO: check this is still correct when the cross product was calculated in single precision
+        return false;
+    return det > 0;
+}
+
+inline bool counterclockwise(real_t px, real_t py, real_t qx, real_t qy, real_t rx, real_t ry)
+{
+    godot::Vector2 p0(px, py);
+    godot::Vector2 p1(qx, qy);
+    godot::Vector2 p2(rx, ry);
+
+    return counterclockwise(p0, p1, p2);
+}
+
+inline Point circumcenter(
+    const godot::Vector2& a,
+    const godot::Vector2& b,
+    const godot::Vector2& c) {
+
+    const double ax = static_cast<double>(a.x);
+    const double ay = static_cast<double>(a.y);
+    const double dx = b.x - ax;
+    const double dy = b.y - ay;
+    const double ex = c.x - ax;
+    const double ey = c.y - ay;
+
+    const double bl = dx * dx + dy * dy;
+    const double cl = ex * ex + ey * ey;
+    //ABELL - This is suspect for div-by-0.
+    const double d = dx * ey - dy * ex;
+
+    const double x = ax + (ey * bl - dy * cl) * 0.5 / d;
+    const double y = ay + (dx * cl - ex * bl) * 0.5 / d;
+
+    return Point(x, y);
+}
+
+inline bool in_circle(
+    const godot::Vector2& a,
+    const godot::Vector2& b,
+    const godot::Vector2& c,
+    const godot::Vector2& p) {
+
+    const double px = static_cast<double>(p.x);
+    const double py = static_cast<double>(p.y);
+    const double dx = a.x - px;
+    const double dy = a.y - py;
+    const double ex = b.x - px;
+    const double ey = b.y - py;
+    const double fx = c.x - px;
+    const double fy = c.y - py;
+
+    const double ap = dx * dx + dy * dy;
+    const double bp = ex * ex + ey * ey;
+    const double cp = fx * fx + fy * fy;
+
+    return (dx * (ey * cp - bp * fy) -
+            dy * (ex * cp - bp * fx) +
+            ap * (ex * fy - ey * fx)) < 0.0;
+}
+
+} //namespace delaunator_cpp
@@ -0,0 +1,722 @@
+#include "fuzz.hpp"
+
+#ifdef DEBUG_ENABLED
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "deduplicate.hpp"
+#include "delaunator.hpp"
+#include "relax.hpp"
+#include "tile_set.hpp"
+#include "validate.hpp"
+
+namespace delaunator_cpp {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Random = std::mt19937_64;
+
+// Fixed allowance in a case's time budget, for timer and scheduling noise
+constexpr double SLOW_ALLOWANCE_MS = 10.0;
+constexpr std::size_t MAX_MINIMIZE_ATTEMPTS = 1000;
+constexpr double TAU = 6.28318530717958647692;
+// Time allowed for deduplicating the regression case's cluster
+constexpr double CLUSTER_BUDGET_MS = 5000.0;
+
+// The generators draw from the engine's raw output rather than the standard
+// distributions, whose results differ between standard libraries, so a
+// case seed gives the same points everywhere.
+inline double unit(Random& random)
+{
+    return static_cast<double>(random() >> 11) * 0x1.0p-53;
+}
+
+inline std::size_t below(Random& random, std::size_t n)
+{
+    return static_cast<std::size_t>(random() % n);
+}
+
+inline std::uint64_t mix(std::uint64_t seed, std::uint64_t index)
+{
+    // splitmix64
+    std::uint64_t z = seed + (index + 1) * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+void shuffle(godot::PackedVector2Array& points, Random& random)
+{
+    godot::Vector2 *p = points.ptrw();
+    for (std::size_t i = points.size(); i > 1; i--) {
+        std::swap(p[i - 1], p[below(random, i)]);
+    }
+}
+
+godot::PackedVector2Array uniform(Random& random, std::size_t count)
+{
+    godot::PackedVector2Array points;
+    points.resize(count);
+    godot::Vector2 *p = points.ptrw();
+    for (std::size_t i = 0; i < count; i++) {
+        p[i] = godot::Vector2(static_cast<real_t>(1000.0 * unit(random)), static_cast<real_t>(1000.0 * unit(random)));
+    }
+    return points;
+}
+
+// A square lattice, whose cells are all cocircular quads.
+godot::PackedVector2Array grid(Random& random, std::size_t count)
+{
+    const std::size_t side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    const double spacing = std::ldexp(1.0, static_cast<int>(below(random, 7)) - 3);
+    godot::PackedVector2Array points;
+    points.resize(count);
+    godot::Vector2 *p = points.ptrw();
+    for (std::size_t i = 0; i < count; i++) {
+        p[i] = godot::Vector2(static_cast<real_t>(spacing * (i % side)), static_cast<real_t>(spacing * (i / side)));
+    }
+    shuffle(points, random);
+    return points;
+}
+
+// Points on one line, with repeats, and half the time one point off it so
+// the hull has long collinear runs.
+godot::PackedVector2Array collinear(Random& random, std::size_t count)
+{
+    int dx = static_cast<int>(below(random, 11)) - 5;
+    const int dy = static_cast<int>(below(random, 11)) - 5;
+    if (dx == 0 && dy == 0) dx = 1;
+    const godot::Vector2 origin(static_cast<real_t>(below(random, 100)), static_cast<real_t>(below(random, 100)));
+    godot::PackedVector2Array points;
+    points.resize(count);
+    godot::Vector2 *p = points.ptrw();
+    for (std::size_t i = 0; i < count; i++) {
+        const real_t step = static_cast<real_t>(below(random, 4 * count));
+        p[i] = origin + godot::Vector2(dx * step, dy * step);
+    }
+    if (random() & 1) {
+        p[below(random, count)] = origin + godot::Vector2(static_cast<real_t>(-dy), static_cast<real_t>(dx));
+    }
+    return points;
+}
+
+// The 972 lattice points on a circle of radius 5 * 13 * 17 * 29 * 37, which
+// are exactly cocircular, or else points rounded onto a circle.
+godot::PackedVector2Array cocircular(Random& random, std::size_t count)
+{
+    static const std::vector<godot::Vector2> lattice_circle = [] {
+        constexpr std::int64_t r = 5 * 13 * 17 * 29 * 37;
+        std::vector<godot::Vector2> circle;
+        for (std::int64_t x = 0; x < r; x++) {
+            const std::int64_t y_squared = r * r - x * x;
+            const std::int64_t y = std::llround(std::sqrt(static_cast<double>(y_squared)));
+            if (y * y != y_squared) continue;
+            // each quadrant, starting on an axis
+            circle.emplace_back(static_cast<real_t>(x), static_cast<real_t>(y));
+            circle.emplace_back(static_cast<real_t>(y), static_cast<real_t>(-x));
+            circle.emplace_back(static_cast<real_t>(-x), static_cast<real_t>(-y));
+            circle.emplace_back(static_cast<real_t>(-y), static_cast<real_t>(x));
+        }
+        return circle;
+    }();
+
+    godot::PackedVector2Array points;
+    points.resize(count);
+    godot::Vector2 *p = points.ptrw();
+    if (random() & 1) {
+        for (std::size_t i = 0; i < count; i++) {
+            p[i] = lattice_circle[below(random, lattice_circle.size())];
+        }
+    } else {
+        const double radius = 1.0 + 1000.0 * unit(random);
+        for (std::size_t i = 0; i < count; i++) {
+            const double angle = TAU * i / count;
+            p[i] = godot::Vector2(static_cast<real_t>(radius * std::cos(angle)), static_cast<real_t>(radius * std::sin(angle)));
+        }
+    }
+    // sometimes with the centre too
+    if (random() & 1) {
+        p[below(random, count)] = godot::Vector2();
+    }
+    return points;
+}
+
+// Points on a line, each nudged a few units in the last place off it.
+godot::PackedVector2Array near_collinear(Random& random, std::size_t count)
+{
+    const double slope = 2.0 * unit(random) - 1.0;
+    godot::PackedVector2Array points;
+    points.resize(count);
+    godot::Vector2 *p = points.ptrw();
+    for (std::size_t i = 0; i < count; i++) {
+        const real_t x = static_cast<real_t>(1000.0 * unit(random));
+        real_t y = static_cast<real_t>(slope * x + 3.0);
+        for (std::size_t ulps = below(random, 5); ulps > 0; ulps--) {
+            y = std::nextafter(y, (ulps & 1) ? std::numeric_limits<real_t>::max() : std::numeric_limits<real_t>::lowest());
+        }
+        p[i] = godot::Vector2(x, y);
+    }
+    return points;
+}
+
+// Points a few units in the last place apart, far from the origin.
+godot::PackedVector2Array huge(Random& random, std::size_t count)
+{
+    const double origin = std::pow(10.0, 6.0 + static_cast<double>(below(random, 25)));
+    const double ulp = static_cast<double>(std::nextafter(static_cast<real_t>(origin), std::numeric_limits<real_t>::max())) -
+                       static_cast<real_t>(origin);
+    godot::PackedVector2Array points;
+    points.resize(count);
+    godot::Vector2 *p = points.ptrw();
+    for (std::size_t i = 0; i < count; i++) {
+        p[i] = godot::Vector2(
+            static_cast<real_t>(origin + ulp * below(random, 64)),
+            static_cast<real_t>(origin + ulp * below(random, 64)));
+    }
+    return points;
+}
+
+// Few distinct points, each repeated many times.
+godot::PackedVector2Array duplicates(Random& random, std::size_t count)
+{
+    const godot::PackedVector2Array distinct = uniform(random, std::max<std::size_t>(3, count / 8));
+    godot::PackedVector2Array points;
+    points.resize(count);
+    godot::Vector2 *p = points.ptrw();
+    for (std::size_t i = 0; i < count; i++) {
+        p[i] = distinct[below(random, distinct.size())];
+    }
+    return points;
+}
+
+// Tiny clusters far apart, each spanning only a few units in the last place.
+godot::PackedVector2Array clusters(Random& random, std::size_t count)
+{
+    const godot::PackedVector2Array centers = uniform(random, 1 + below(random, 4));
+    godot::PackedVector2Array points;
+    points.resize(count);
+    godot::Vector2 *p = points.ptrw();
+    for (std::size_t i = 0; i < count; i++) {
+        const godot::Vector2& center = centers[below(random, centers.size())];
+        p[i] = center * static_cast<real_t>(10.0) + godot::Vector2(
+            static_cast<real_t>(1e-3 * unit(random)),
+            static_cast<real_t>(1e-3 * unit(random)));
+    }
+    return points;
+}
+
+struct Generator {
+    const char *name;
+    godot::PackedVector2Array (*generate)(Random& random, std::size_t count);
+};
+
+const Generator GENERATORS[] = {
+    { "uniform", uniform },
+    { "grid", grid },
+    { "collinear", collinear },
+    { "cocircular", cocircular },
+    { "near_collinear", near_collinear },
+    { "huge", huge },
+    { "duplicates", duplicates },
+    { "clusters", clusters },
+};
+constexpr std::size_t GENERATOR_COUNT = sizeof(GENERATORS) / sizeof(GENERATORS[0]);
+
+struct CaseResult {
+    std::string problem;
+    // time taken by the sweep
+    double milliseconds = 0.0;
+};
+
+CaseResult run_case(const godot::PackedVector2Array& points)
+{
+    CaseResult result;
+    std::unique_ptr<Delaunator> delaunator;
+    const Clock::time_point start = Clock::now();
+    try {
+        delaunator.reset(new Delaunator(points));
+    } catch (const std::runtime_error&) {
+    }
+    result.milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    if (!delaunator) {
+        if (!exactly_collinear(points)) result.problem = "the sweep rejected points which aren't collinear";
+        return result;
+    }
+    result.problem = validate(*delaunator);
+    if (!result.problem.empty()) return result;
+
+    // the same points reached by repairing a triangulation of them jittered
+    // by a fraction of their spacing
+    const std::size_t n = points.size();
+    double min_x = points[0].x, min_y = points[0].y;
+    double max_x = points[0].x, max_y = points[0].y;
+    for (std::size_t i = 1; i < n; i++) {
+        min_x = std::min<double>(min_x, points[i].x);
+        min_y = std::min<double>(min_y, points[i].y);
+        max_x = std::max<double>(max_x, points[i].x);
+        max_y = std::max<double>(max_y, points[i].y);
+    }
+    const double jitter = 1e-3 * std::hypot(max_x - min_x, max_y - min_y) / std::sqrt(static_cast<double>(n));
+    Random random(n);
+    godot::PackedVector2Array jittered = points;
+    godot::Vector2 *p = jittered.ptrw();
+    for (std::size_t i = 0; i < n; i++) {
+        p[i] += godot::Vector2(
+            static_cast<real_t>(jitter * (2.0 * unit(random) - 1.0)),
+            static_cast<real_t>(jitter * (2.0 * unit(random) - 1.0)));
+    }
+    try {
+        Delaunator repaired(jittered);
+        repaired.update_positions(points, 1.0);
+        result.problem = validate(repaired);
+        if (!result.problem.empty()) result.problem = "after update_positions(): " + result.problem;
+    } catch (const std::runtime_error&) {
+        // the jittered points were rejected, which the sweep is checked for
+        // with the points themselves
+    }
+    return result;
+}
+
+// Runs the case on a thread of its own, so a case which hangs can be given
+// up on. Returns false if it hasn't finished within 'hang_seconds', leaving
+// the thread running.
+bool run_watched(const godot::PackedVector2Array& points, double hang_seconds, CaseResult& result)
+{
+    struct Watch {
+        std::mutex mutex;
+        std::condition_variable finished;
+        bool done = false;
+        CaseResult result;
+    };
+    std::shared_ptr<Watch> watch = std::make_shared<Watch>();
+
+    std::thread([watch, points] {
+        CaseResult case_result = run_case(points);
+        std::lock_guard<std::mutex> lock(watch->mutex);
+        watch->result = std::move(case_result);
+        watch->done = true;
+        watch->finished.notify_all();
+    }).detach();
+
+    std::unique_lock<std::mutex> lock(watch->mutex);
+    if (!watch->finished.wait_for(lock, std::chrono::duration<double>(hang_seconds), [&] { return watch->done; })) {
+        return false;
+    }
+    result = watch->result;
+    return true;
+}
+
+// Delta debugging (ddmin) over the points: removes ever smaller chunks of
+// them for as long as what's left still fails, keeping at least 3. Returns
+// false if a candidate hung, leaving it in 'hung'.
+bool minimize(
+    godot::PackedVector2Array& points,
+    std::string& problem,
+    double hang_seconds,
+    godot::PackedVector2Array& hung)
+{
+    std::size_t chunks = 2;
+    std::size_t attempts = 0;
+    while (points.size() > 3 && attempts < MAX_MINIMIZE_ATTEMPTS) {
+        const std::size_t n = points.size();
+        const std::size_t chunk = (n + chunks - 1) / chunks;
+        bool reduced = false;
+        for (std::size_t start = 0; start < n && !reduced && attempts < MAX_MINIMIZE_ATTEMPTS; start += chunk) {
+            const std::size_t end = std::min(n, start + chunk);
+            if (n - (end - start) < 3) continue;
+
+            godot::PackedVector2Array candidate;
+            candidate.resize(n - (end - start));
+            godot::Vector2 *c = candidate.ptrw();
+            for (std::size_t i = 0; i < start; i++) {
+                *c++ = points[i];
+            }
+            for (std::size_t i = end; i < n; i++) {
+                *c++ = points[i];
+            }
+
+            attempts++;
+            CaseResult result;
+            if (!run_watched(candidate, hang_seconds, result)) {
+                hung = candidate;
+                return false;
+            }
+            if (!result.problem.empty()) {
+                points = candidate;
+                problem = result.problem;
+                chunks = std::max<std::size_t>(chunks - 1, 2);
+                reduced = true;
+            }
+        }
+        if (!reduced) {
+            if (chunk == 1) break;
+            chunks = std::min(n, 2 * chunks);
+        }
+    }
+    return true;
+}
+
+// The regression cases, for bugs found by fuzzing or review. Each returns
+// a description of the first problem, or an empty string, and only uses
+// fixed seeds so a failure replays the same way.
+
+// Collinear and near-collinear points, which the sweep's hull handling and
+// collinearity test have got wrong before.
+std::string regress_collinear_sweep()
+{
+    const std::size_t sweep_generators[] = { 2, 4 }; // collinear, near_collinear
+    for (std::size_t generator : sweep_generators) {
+        for (std::uint64_t case_seed = 0; case_seed < 32; case_seed++) {
+            for (std::size_t count : { 3, 4, 5, 16, 256 }) {
+                const std::string problem = check_points(fuzz_points(generator, case_seed, count));
+                if (!problem.empty()) {
+                    return std::string(GENERATORS[generator].name) + " case_seed " + std::to_string(case_seed) +
+                           ", " + std::to_string(count) + " points: " + problem;
+                }
+            }
+        }
+    }
+
+    // points at most 5e-5 off a line, so most land on hull edges as they're
+    // inserted
+    Random random(3);
+    for (std::size_t c = 0; c < 2000; c++) {
+        godot::PackedVector2Array points;
+        points.resize(4 + below(random, 30));
+        godot::Vector2 *p = points.ptrw();
+        for (std::size_t i = 0; i < static_cast<std::size_t>(points.size()); i++) {
+            p[i] = godot::Vector2(static_cast<real_t>(below(random, 50)), static_cast<real_t>(below(random, 50)) * static_cast<real_t>(1e-6));
+        }
+        const std::string problem = check_points(points);
+        if (!problem.empty()) return "line case " + std::to_string(c) + ": " + problem;
+    }
+    return std::string();
+}
+
+// Tiny tolerances over huge spreads, whose grid cell indices used to
+// overflow, and a tolerance of 0 over a tight cluster, which used to be
+// compared pairwise.
+std::string regress_deduplicate_grid()
+{
+    Random random(4);
+    godot::PackedVector2Array points;
+    for (std::size_t i = 0; i < 2000; i++) {
+        points.push_back(godot::Vector2(
+            static_cast<real_t>(2e30 * unit(random) - 1e30),
+            static_cast<real_t>(2e30 * unit(random) - 1e30)));
+    }
+    const std::size_t duplicate = points.size();
+    points.push_back(points[5]);
+    points.push_back(godot::Vector2(std::numeric_limits<real_t>::infinity(), 1));
+    points.push_back(godot::Vector2(std::numeric_limits<real_t>::quiet_NaN(), 2));
+
+    for (double tolerance : { 1e-300, 1e-20, 0.0 }) {
+        std::vector<std::size_t> remap;
+        deduplicate(points, tolerance, remap);
+        const std::string at = "tolerance " + std::to_string(tolerance) + ": ";
+        if (remap.size() != static_cast<std::size_t>(points.size())) return at + "remap has the wrong size";
+        if (remap[duplicate] != 5) return at + "an exact duplicate wasn't merged";
+        for (std::size_t i = 0; i < remap.size(); i++) {
+            if (remap[i] > i) return at + "point " + std::to_string(i) + " was merged into a later point";
+            if (remap[i] != i && static_cast<double>(points[i].distance_to(points[remap[i]])) > tolerance) {
+                return at + "point " + std::to_string(i) + " was merged into a distant point";
+            }
+        }
+    }
+
+    // A tight cluster of distinct points and one far outlier, which put
+    // every point in one cell when a tolerance of 0 sized the cells from
+    // the extent. Comparing the cluster pairwise takes tens of seconds, so
+    // the budget is far above the time hashing takes, whatever the machine.
+    godot::PackedVector2Array cluster;
+    for (std::size_t i = 0; i < 200000; i++) {
+        cluster.push_back(godot::Vector2(static_cast<real_t>(1e-3 * (i % 450)), static_cast<real_t>(1e-3 * (i / 450))));
+    }
+    cluster.push_back(godot::Vector2(1e9, 1e9));
+    cluster.push_back(cluster[5]);
+    cluster.push_back(godot::Vector2(static_cast<real_t>(-0.0), 0));
+    const std::size_t n = cluster.size();
+    std::vector<std::size_t> remap;
+    const Clock::time_point start = Clock::now();
+    const std::size_t kept = deduplicate(cluster, 0.0, remap).size();
+    const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    if (kept != n - 2 || remap[n - 2] != 5 || remap[n - 1] != 0) return "a cluster's exact duplicates weren't merged";
+    if (milliseconds > CLUSTER_BUDGET_MS) {
+        return "merging a cluster's exact duplicates took " + std::to_string(milliseconds) + " ms";
+    }
+    return std::string();
+}
+
+// Relaxing into bounds narrower than a float step, which leaves every point
+// on one line, and relaxing points the sweep skipped as duplicates.
+std::string regress_relax()
+{
+    godot::PackedVector2Array points = fuzz_points(0, 9, 300);
+    Delaunator clamped(points);
+    bool threw = false;
+    try {
+        relax(clamped, 5, godot::Rect2(1e6, 0, 0.01, 100));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw) return "relaxing onto one line didn't throw";
+    std::string problem = validate(clamped);
+    if (!problem.empty()) return "after relaxing onto one line: " + problem;
+
+    for (std::size_t i = 0; i < 100; i++) {
+        points.push_back(points[i % 50]);
+    }
+    Delaunator duplicated(points);
+    relax(duplicated, 1, godot::Rect2(0, 0, 1000, 1000));
+    if (!duplicated.skipped.empty()) return "an iteration of relaxing left duplicates skipped";
+    relax(duplicated, 3, godot::Rect2(0, 0, 1000, 1000));
+    problem = validate(duplicated);
+    if (!problem.empty()) return "after relaxing duplicates: " + problem;
+    return std::string();
+}
+
+using TriangleKey = std::array<std::pair<real_t, real_t>, 3>;
+
+TriangleKey triangle_key(const godot::Vector2& a, const godot::Vector2& b, const godot::Vector2& c)
+{
+    TriangleKey key = { { { a.x, a.y }, { b.x, b.y }, { c.x, c.y } } };
+    std::sort(key.begin(), key.end());
+    return key;
+}
+
+// Checks the loaded tiles' triangles are those of all their points
+// triangulated at once, each in exactly one tile.
+std::string compare_tiles(const TileSet& tiles)
+{
+    godot::PackedVector2Array all;
+    std::vector<TriangleKey> owned;
+    for (const godot::Vector2i& key : tiles.get_loaded_tiles()) {
+        const TileSet::Tile *tile = tiles.get_tile(key);
+        all.append_array(tile->points);
+        for (std::size_t e = 0; e < tile->triangles.size(); e += 3) {
+            owned.push_back(triangle_key(
+                tile->vertices[tile->triangles[e]],
+                tile->vertices[tile->triangles[e + 1]],
+                tile->vertices[tile->triangles[e + 2]]));
+        }
+    }
+    const Delaunator delaunator(all);
+    std::vector<TriangleKey> expected;
+    for (std::size_t e = 0; e < delaunator.triangles.size(); e += 3) {
+        expected.push_back(triangle_key(
+            all[delaunator.triangles[e]],
+            all[delaunator.triangles[e + 1]],
+            all[delaunator.triangles[e + 2]]));
+    }
+    std::sort(owned.begin(), owned.end());
+    std::sort(expected.begin(), expected.end());
+    if (std::adjacent_find(owned.begin(), owned.end()) != owned.end()) return "a triangle is in more than one tile";
+    if (owned != expected) {
+        return "the tiles have " + std::to_string(owned.size()) + " triangles, not the " +
+               std::to_string(expected.size()) + " of their points triangulated at once";
+    }
+    return std::string();
+}
+
+// Which tile owns each seam triangle, as tiles load and unload around
+// sparse and empty ones, and a tile of points on one line beside an
+// ordinary one.
+std::string regress_tile_seams()
+{
+    constexpr double TILE_SIZE = 100.0;
+    TileSet tiles(TILE_SIZE);
+    std::vector<godot::Vector2i> keys;
+    std::vector<godot::PackedVector2Array> points;
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            const std::size_t count = (x + y) % 5 == 0 ? 3 : ((x * 7 + y) % 4 == 0 ? 10 : 200);
+            godot::PackedVector2Array tile_points = fuzz_points(0, static_cast<std::uint64_t>(4 * y + x), count);
+            godot::Vector2 *p = tile_points.ptrw();
+            for (std::size_t i = 0; i < count; i++) {
+                p[i] = p[i] * static_cast<real_t>(TILE_SIZE / 1000.0) + godot::Vector2(
+                    static_cast<real_t>(x * TILE_SIZE), static_cast<real_t>(y * TILE_SIZE));
+            }
+            keys.push_back(godot::Vector2i(x, y));
+            points.push_back(x == 1 && y == 2 ? godot::PackedVector2Array() : tile_points);
+        }
+    }
+
+    tiles.load_tiles(keys, points);
+    std::string problem = compare_tiles(tiles);
+    if (!problem.empty()) return "after loading: " + problem;
+    tiles.unload_tiles({ godot::Vector2i(0, 0), godot::Vector2i(2, 2) });
+    problem = compare_tiles(tiles);
+    if (!problem.empty()) return "after unloading: " + problem;
+    tiles.load_tiles({ godot::Vector2i(2, 2) }, { points[10] });
+    problem = compare_tiles(tiles);
+    if (!problem.empty()) return "after reloading: " + problem;
+
+    // Points exactly on the line y = 3x whose differences don't fit in a
+    // double, so a rounded orientation test takes them for a triangle and
+    // the sweep throws on them, beside a tile of points exactly on a line
+    // and an ordinary one.
+    constexpr double LINE_TILE_SIZE = 2048.0;
+    TileSet lined(LINE_TILE_SIZE);
+    godot::PackedVector2Array rounded;
+    rounded.push_back(godot::Vector2(static_cast<real_t>(0x1.c68p-46), static_cast<real_t>(0x1.54ep-44)));
+    rounded.push_back(godot::Vector2(584, 1752));
+    rounded.push_back(godot::Vector2(33, 99));
+    godot::PackedVector2Array line;
+    for (int i = 0; i < 20; i++) {
+        line.push_back(godot::Vector2(static_cast<real_t>(50 * i), static_cast<real_t>(LINE_TILE_SIZE + 25 * i)));
+    }
+    godot::PackedVector2Array ordinary = fuzz_points(0, 1, 50);
+    godot::Vector2 *p = ordinary.ptrw();
+    for (std::size_t i = 0; i < 50; i++) {
+        p[i] = p[i] * static_cast<real_t>(2) + godot::Vector2(static_cast<real_t>(LINE_TILE_SIZE), 0);
+    }
+    try {
+        lined.load_tiles(
+            { godot::Vector2i(0, 0), godot::Vector2i(0, 1), godot::Vector2i(1, 0) },
+            { rounded, line, ordinary });
+    } catch (const std::runtime_error& error) {
+        return std::string("loading tiles of points on one line threw: ") + error.what();
+    }
+    problem = compare_tiles(lined);
+    if (!problem.empty()) return "with tiles of points on one line: " + problem;
+    return std::string();
+}
+
+struct Regression {
+    const char *name;
+    std::string (*check)();
+};
+
+const Regression REGRESSIONS[] = {
+    { "collinear_sweep", regress_collinear_sweep },
+    { "deduplicate_grid", regress_deduplicate_grid },
+    { "relax", regress_relax },
+    { "tile_seams", regress_tile_seams },
+};
+
+} // namespace
+
+const std::vector<std::string>& fuzz_generators()
+{
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> result;
+        for (const Generator& generator : GENERATORS) {
+            result.push_back(generator.name);
+        }
+        return result;
+    }();
+    return names;
+}
+
+godot::PackedVector2Array fuzz_points(std::size_t generator, std::uint64_t case_seed, std::size_t count)
+{
+    Random random(case_seed);
+    return GENERATORS[generator % GENERATOR_COUNT].generate(random, std::max<std::size_t>(count, 3));
+}
+
+std::string check_points(const godot::PackedVector2Array& points)
+{
+    return run_case(points).problem;
+}
+
+FuzzReport fuzz(const FuzzOptions& options)
+{
+    FuzzReport report;
+    const Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+    const std::size_t max_points = std::max<std::size_t>(options.max_points, 3);
+
+    for (std::uint64_t index = 0; Clock::now() < deadline; index++) {
+        const std::size_t generator = index % GENERATOR_COUNT;
+        const std::uint64_t case_seed = mix(options.seed, index);
+
+        // sizes spread evenly on a log scale, as small cases find as much
+        Random random(case_seed);
+        const std::size_t count = std::max<std::size_t>(3, static_cast<std::size_t>(std::pow(static_cast<double>(max_points), unit(random))));
+        godot::PackedVector2Array points = fuzz_points(generator, case_seed, count);
+        if (options.on_case) options.on_case(GENERATORS[generator].name, case_seed, count);
+
+        FuzzFailure failure;
+        failure.generator = GENERATORS[generator].name;
+        failure.case_seed = case_seed;
+        failure.original_size = count;
+
+        CaseResult result;
+        if (!run_watched(points, options.hang_seconds, result)) {
+            failure.kind = FuzzFailureKind::HANG;
+            failure.message = "still running after " + std::to_string(options.hang_seconds) + " s";
+            failure.points = points;
+            failure.milliseconds = 1000.0 * options.hang_seconds;
+            report.failures.push_back(std::move(failure));
+            break;
+        }
+        report.cases++;
+
+        if (!result.problem.empty()) {
+            godot::PackedVector2Array hung;
+            const bool finished = minimize(points, result.problem, options.hang_seconds, hung);
+            failure.kind = FuzzFailureKind::INVALID;
+            failure.message = result.problem;
+            failure.points = points;
+            failure.milliseconds = result.milliseconds;
+            report.failures.push_back(failure);
+            if (!finished) {
+                failure.kind = FuzzFailureKind::HANG;
+                failure.message = "still running after " + std::to_string(options.hang_seconds) + " s, while minimizing";
+                failure.points = hung;
+                failure.milliseconds = 1000.0 * options.hang_seconds;
+                report.failures.push_back(std::move(failure));
+                break;
+            }
+            continue;
+        }
+
+        // a slow case is timed again before it counts, to rule out noise
+        const double budget = SLOW_ALLOWANCE_MS + 1e-3 * options.microseconds_per_point * count;
+        if (result.milliseconds > budget) {
+            CaseResult again;
+            if (run_watched(points, options.hang_seconds, again)) {
+                result.milliseconds = std::min(result.milliseconds, again.milliseconds);
+            }
+            if (result.milliseconds > budget) {
+                failure.kind = FuzzFailureKind::SLOW;
+                failure.message = "took " + std::to_string(result.milliseconds) + " ms, over the budget of " + std::to_string(budget) + " ms";
+                failure.points = points;
+                failure.milliseconds = result.milliseconds;
+                report.failures.push_back(std::move(failure));
+            }
+        }
+    }
+    return report;
+}
+
+std::vector<std::string> check_regressions()
+{
+    std::vector<std::string> failures;
+    for (const Regression& regression : REGRESSIONS) {
+        std::string problem;
+        try {
+            problem = regression.check();
+        } catch (const std::exception& error) {
+            problem = std::string("threw: ") + error.what();
+        }
+        if (!problem.empty()) failures.push_back(std::string(regression.name) + ": " + problem);
+    }
+    return failures;
+}
+
+} //namespace delaunator_cpp
+
+#endif // DEBUG_ENABLED
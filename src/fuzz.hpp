@@ -0,0 +1,84 @@
+#pragma once
+
+// The fuzzer is a debugging aid, and isn't built into release libraries.
+#ifdef DEBUG_ENABLED
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+
+namespace delaunator_cpp {
+
+struct FuzzOptions {
+    std::uint64_t seed = 0;
+    // how long to keep generating cases for
+    double seconds = 10.0;
+    std::size_t max_points = 5000;
+    // a case fails as too slow when its sweep takes longer than this per
+    // point, on top of a fixed allowance for timer and scheduling noise
+    double microseconds_per_point = 5.0;
+    // a case still running after this long is taken to hang, which ends
+    // the run; the case is left running on a detached thread, so the
+    // process should exit without unloading the code it's in
+    double hang_seconds = 10.0;
+    // called before each case runs, so a case which crashes can be found
+    // from a log
+    std::function<void(const std::string& generator, std::uint64_t case_seed, std::size_t count)> on_case;
+};
+
+enum class FuzzFailureKind {
+    INVALID, // the triangulation failed validate(), or the sweep threw
+    SLOW,
+    HANG
+};
+
+struct FuzzFailure {
+    FuzzFailureKind kind;
+    std::string generator;
+    // reproduces the case with fuzz_points()
+    std::uint64_t case_seed;
+    std::size_t original_size;
+    // the problem found in 'points'
+    std::string message;
+    // the case's points, cut down to a smallest subset which still fails
+    // for INVALID failures
+    godot::PackedVector2Array points;
+    double milliseconds;
+};
+
+struct FuzzReport {
+    std::size_t cases = 0;
+    std::vector<FuzzFailure> failures;
+};
+
+// Names of the point generators, which the cases cycle through: uniform,
+// grid, collinear, cocircular, near_collinear, huge, duplicates, clusters.
+const std::vector<std::string>& fuzz_generators();
+
+godot::PackedVector2Array fuzz_points(std::size_t generator, std::uint64_t case_seed, std::size_t count);
+
+// Triangulates the points and checks the result with validate(). The
+// triangulation is also repaired onto the points with update_positions()
+// from a jittered copy, and that checked the same way, so both paths are
+// held to the exact predicates. Input the sweep rejects must be collinear.
+// Returns a description of the first problem, or an empty string.
+std::string check_points(const godot::PackedVector2Array& points);
+
+// Runs check_points() on generated cases until options.seconds have passed
+// or a case hangs. Cases which fail are minimized by delta debugging: chunks
+// of points are removed for as long as what's left still fails.
+FuzzReport fuzz(const FuzzOptions& options);
+
+// Replays fixed cases for bugs found so far: generated collinear and
+// near-collinear sweeps, deduplicating with tiny tolerances over huge
+// spreads, relax() onto one line and over skipped duplicates, and the
+// ownership of seam triangles in a TileSet. Returns "name: problem" for
+// each case which fails.
+std::vector<std::string> check_regressions();
+
+} //namespace delaunator_cpp
+
+#endif // DEBUG_ENABLED
@@ -2,23 +2,88 @@
 
 #include "gddelaunator.h"
 
+#include <algorithm>
+#include <exception>
+#include <string>
+
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/error_macros.hpp>
 
 #include <godot_cpp/classes/global_constants.hpp>
 #include <godot_cpp/classes/label.hpp>
+#include <godot_cpp/classes/mesh.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include "gddelaunator_arrays.h"
 #include "delaunator.hpp"
+#include "alpha_shape.hpp"
+#include "cache.hpp"
+#include "deduplicate.hpp"
+#include "graph.hpp"
+#include "hull.hpp"
+#include "interpolation.hpp"
+#include "mesh.hpp"
+#include "parallel.hpp"
+#include "path_finding.hpp"
+#include "periodic.hpp"
+#include "relax.hpp"
+#include "traversal.hpp"
+#include "validate.hpp"
+#include "voronoi.hpp"
 
 using namespace godot;
 
+static Error to_error(delaunator_cpp::CacheStatus status) {
+
+  switch (status) {
+    case delaunator_cpp::CacheStatus::OK: return OK;
+    case delaunator_cpp::CacheStatus::CANT_OPEN: return ERR_FILE_CANT_OPEN;
+    case delaunator_cpp::CacheStatus::CANT_WRITE: return ERR_FILE_CANT_WRITE;
+    case delaunator_cpp::CacheStatus::UNRECOGNIZED: return ERR_FILE_UNRECOGNIZED;
+    case delaunator_cpp::CacheStatus::CORRUPT: return ERR_FILE_CORRUPT;
+  }
+  return FAILED;
+}
+
+static std::string to_file_path(const String& path) {
+  return ProjectSettings::get_singleton()->globalize_path(path).utf8().get_data();
+}
+
 void Delaunator::_bind_methods() {
 	
   // Constants
 	BIND_CONSTANT(INVALID_INDEX);
 
   // Functions
-	ClassDB::bind_method(D_METHOD("from"), &Delaunator::from);
+	ClassDB::bind_method(D_METHOD("from", "points", "tolerance"), &Delaunator::from, DEFVAL(0.0));
+	ClassDB::bind_method(D_METHOD("from_periodic", "points", "domain"), &Delaunator::from_periodic);
+	ClassDB::bind_method(D_METHOD("compute_hull", "points"), &Delaunator::compute_hull);
+	ClassDB::bind_method(D_METHOD("update_positions", "points", "max_flip_fraction"), &Delaunator::update_positions, DEFVAL(0.25));
+	ClassDB::bind_method(D_METHOD("relax", "points", "iterations", "bounds"), &Delaunator::relax);
+	ClassDB::bind_method(D_METHOD("from_cached", "points", "path"), &Delaunator::from_cached);
+	ClassDB::bind_method(D_METHOD("save", "path", "include_derived"), &Delaunator::save, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("load", "path"), &Delaunator::load);
+	ClassDB::bind_method(D_METHOD("get_result"), &Delaunator::get_result);
+	ClassDB::bind_method(D_METHOD("get_point_remap"), &Delaunator::get_point_remap);
+	ClassDB::bind_method(D_METHOD("get_skipped_points"), &Delaunator::get_skipped_points);
+	ClassDB::bind_method(D_METHOD("get_alpha_shape", "alpha"), &Delaunator::get_alpha_shape);
+	ClassDB::bind_method(D_METHOD("interpolate_linear", "values", "query_points"), &Delaunator::interpolate_linear);
+	ClassDB::bind_method(D_METHOD("interpolate_natural_neighbor", "values", "query_points"), &Delaunator::interpolate_natural_neighbor);
+	ClassDB::bind_method(D_METHOD("rasterize", "values", "rect", "size"), &Delaunator::rasterize);
+	ClassDB::bind_method(D_METHOD("build_mesh", "heights", "uvs", "tangents"), &Delaunator::build_mesh, DEFVAL(false), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_minimum_spanning_tree"), &Delaunator::get_minimum_spanning_tree);
+	ClassDB::bind_method(D_METHOD("get_nearest_neighbors"), &Delaunator::get_nearest_neighbors);
+	ClassDB::bind_method(D_METHOD("find_path", "from_point", "to_point"), &Delaunator::find_path);
+	ClassDB::bind_method(D_METHOD("find_paths", "from_points", "to_points"), &Delaunator::find_paths);
+	ClassDB::bind_method(D_METHOD("find_nearest_paths", "from_points", "to_points"), &Delaunator::find_nearest_paths);
+	ClassDB::bind_method(D_METHOD("flood_fill", "seed_triangle", "edge_mask"), &Delaunator::flood_fill, DEFVAL(PackedByteArray()));
+	ClassDB::bind_method(D_METHOD("get_connected_components", "edge_mask"), &Delaunator::get_connected_components, DEFVAL(PackedByteArray()));
+	ClassDB::bind_method(D_METHOD("get_contours", "values", "level"), &Delaunator::get_contours);
+	ClassDB::bind_method(D_METHOD("validate"), &Delaunator::validate);
+	ClassDB::bind_static_method("Delaunator", D_METHOD("set_worker_count", "count"), &Delaunator::set_worker_count);
+	ClassDB::bind_static_method("Delaunator", D_METHOD("get_worker_count"), &Delaunator::get_worker_count);
 	
   // Properties
 	ClassDB::bind_method(D_METHOD("get_triangles"), &Delaunator::get_triangles);
@@ -30,6 +95,12 @@ void Delaunator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_hull"), &Delaunator::get_hull);
 	ADD_PROPERTY(PropertyInfo(Variant::PACKED_INT32_ARRAY, "hull"), NULL, "get_hull");
 
+	ClassDB::bind_method(D_METHOD("get_wrap_offsets"), &Delaunator::get_wrap_offsets);
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_VECTOR2_ARRAY, "wrap_offsets"), NULL, "get_wrap_offsets");
+
+	ClassDB::bind_method(D_METHOD("get_circumcenters"), &Delaunator::get_circumcenters);
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_VECTOR2_ARRAY, "circumcenters"), NULL, "get_circumcenters");
+
 	ClassDB::bind_method(D_METHOD("get_hull_area"), &Delaunator::get_hull_area);
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "hull_area"), NULL, "get_hull_area");
 
@@ -39,69 +110,668 @@ void Delaunator::_bind_methods() {
 
 Delaunator::Delaunator() {
 	//UtilityFunctions::print("Delaunator Constructor.");
-  delaunator = NULL;
 }
 
 Delaunator::~Delaunator() {
 	//UtilityFunctions::print("Delaunator Destructor.");
-  if (delaunator) delete(delaunator);
-  delaunator = NULL;
 }
 
-void Delaunator::from(PackedVector2Array points) {
-  
-  if (delaunator) delete(delaunator);
-  delaunator = new delaunator_cpp::Delaunator(points);
+// Adds the points the triangulation skipped as duplicates to remap.
+static void remap_skipped_points(const delaunator_cpp::Delaunator& delaunator, std::vector<std::size_t>& remap) {
+
+  if (!delaunator.skipped.empty()) {
+    if (remap.empty()) {
+      remap.resize(delaunator.m_points.size());
+      for(std::size_t i = 0; i < remap.size(); i++) {
+        remap[i] = i;
+      }
+    }
+    delaunator_cpp::remap_skipped(delaunator, remap);
+  }
 }
 
-PackedInt32Array Delaunator::get_triangles() {
+// Triangulates the points. With a tolerance, points within it of an earlier
+// point are merged into that point first and left out of the triangulation;
+// either way get_point_remap() and get_skipped_points() report the points
+// that aren't in any triangle. Points which can't be triangulated (all on
+// one line) leave the previous triangulation in place, with an error.
+void Delaunator::from(PackedVector2Array points, double tolerance) {
+
+  ERR_FAIL_COND_MSG(delaunator_cpp::exactly_collinear(points), "can't triangulate these points: they're all on one line.");
+
+  // Merging can still leave too few points, which the sweep throws for.
+  // Triangulated before taking the lock, so other threads only wait for
+  // the swap
+  std::shared_ptr<delaunator_cpp::Delaunator> triangulated;
+  std::vector<std::size_t> remap;
+  try {
+    if (tolerance > 0) {
+      std::vector<std::size_t> kept = delaunator_cpp::deduplicate(points, tolerance, remap);
+      if (kept.size() == remap.size()) remap.clear(); // nothing merged
+      triangulated = std::make_shared<delaunator_cpp::Delaunator>(points, std::move(kept));
+    } else {
+      triangulated = std::make_shared<delaunator_cpp::Delaunator>(points);
+    }
+  } catch (const std::exception& error) {
+    ERR_FAIL_MSG(String("can't triangulate these points: ") + error.what());
+  }
+  remap_skipped_points(*triangulated, remap);
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  delaunator = std::move(triangulated);
+  point_remap = std::move(remap);
+  merge_tolerance = tolerance;
+  circumradii.clear();
+  inedges.clear();
+  circumcenters.clear();
+  wrap_offsets.clear();
+}
+
+// Triangulates points on a domain which wraps horizontally and vertically.
+// The triangles and halfedges only refer to the original points (wrapped into
+// the domain), every halfedge has a twin and there is no hull. wrap_offsets
+// gives the shift to add to each halfedge's point to place it in its triangle.
+// Points which wrap onto an earlier point are left out, as
+// get_skipped_points() reports.
+//
+// Methods which measure distances or positions across the triangles
+// (get_alpha_shape(), the interpolations, rasterize(), build_mesh(),
+// get_contours(), get_circumcenters(), get_minimum_spanning_tree(),
+// get_nearest_neighbors() and the path finding) would use the unshifted
+// points, so they fail with an error on a periodic triangulation. Those
+// which only follow the halfedges, like flood_fill(), work on it.
+void Delaunator::from_periodic(PackedVector2Array points, Rect2 domain) {
+
+  ERR_FAIL_COND_MSG(domain.size.x <= 0 || domain.size.y <= 0, "domain must have a positive size.");
+
+  std::shared_ptr<delaunator_cpp::Delaunator> triangulated = std::make_shared<delaunator_cpp::Delaunator>();
+  std::vector<Vector2i> offsets;
+  try {
+    delaunator_cpp::triangulate_periodic(points, domain, *triangulated, offsets);
+  } catch (const std::exception& error) {
+    ERR_FAIL_MSG(String("can't triangulate on this domain: ") + error.what());
+  }
+  // points wrapped onto an earlier point map to it
+  std::vector<std::size_t> remap;
+  if (!triangulated->skipped.empty()) {
+    delaunator_cpp::deduplicate(triangulated->m_points, 0, remap);
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  delaunator = std::move(triangulated);
+  wrap_offsets = std::move(offsets);
+  periodic_size = domain.size;
+  circumradii.clear();
+  inedges.clear();
+  circumcenters.clear();
+  point_remap = std::move(remap);
+}
+
+// Finds just the convex hull of the points, for when hull and hull_area are
+// all that's needed: they come out as from() would give them, but there are
+// no triangles or halfedges, and it's far quicker. The hull may start at a
+// different point.
+void Delaunator::compute_hull(PackedVector2Array points) {
+
+  std::shared_ptr<delaunator_cpp::Delaunator> hull = std::make_shared<delaunator_cpp::Delaunator>();
+  delaunator_cpp::compute_hull(points, *hull);
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  delaunator = std::move(hull);
+  point_remap.clear();
+  merge_tolerance = 0;
+  circumradii.clear();
+  inedges.clear();
+  circumcenters.clear();
+  wrap_offsets.clear();
+}
+
+// Moves the points for the next frame, repairing the previous triangulation
+// with edge flips when the points have only moved a little. Falls back to
+// from() when it can't be repaired or needs more than max_flip_fraction of
+// the triangle count in flips. Returns true if it was repaired. Points which
+// can't be triangulated (all on one line) leave the previous triangulation
+// in place, with an error.
+bool Delaunator::update_positions(PackedVector2Array points, double max_flip_fraction) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  if(!delaunator) {
+    from(points, 0);
+    return false;
+  }
+  ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), false, "update_positions() doesn't support periodic triangulations.");
+  ERR_FAIL_COND_V_MSG(max_flip_fraction < 0, false, "max_flip_fraction must not be negative.");
+
+  // points that were merged or skipped are only found again by a rebuild
+  if (!point_remap.empty()) {
+    from(points, merge_tolerance);
+    return false;
+  }
+
+  // the core is left as it was if this throws
+  bool repaired;
+  try {
+    repaired = unshared().update_positions(points, max_flip_fraction);
+  } catch (const std::exception& error) {
+    ERR_FAIL_V_MSG(false, String("can't triangulate these points: ") + error.what());
+  }
+  circumradii.clear();
+  inedges.clear();
+  circumcenters.clear();
+  return repaired;
+}
+
+// Spreads the points out evenly with Lloyd's algorithm, moving each one to
+// the centroid of its Voronoi cell clipped to bounds for the given number of
+// iterations. Returns the relaxed points, which are left triangulated. If an
+// iteration clamps every point onto one line, it stops with an error and
+// returns the previous iteration's points.
+PackedVector2Array Delaunator::relax(PackedVector2Array points, int iterations, Rect2 bounds) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  ERR_FAIL_COND_V_MSG(iterations < 0, points, "iterations must not be negative.");
+  ERR_FAIL_COND_V_MSG(bounds.size.x <= 0 || bounds.size.y <= 0, points, "bounds must have a positive size.");
+
+  ERR_FAIL_COND_V_MSG(delaunator_cpp::exactly_collinear(points), points, "can't triangulate these points: they're all on one line.");
+
+  from(points, 0);
+  if (iterations > 0) {
+    // the core keeps the last iteration it could triangulate
+    String stopped;
+    try {
+      delaunator_cpp::relax(unshared(), iterations, bounds);
+    } catch (const std::exception& error) {
+      stopped = error.what();
+    }
+    point_remap.clear();
+    remap_skipped_points(*delaunator, point_remap);
+    ERR_FAIL_COND_V_MSG(!stopped.is_empty(), delaunator->m_points, String("relaxing stopped early: ") + stopped);
+  }
+  return delaunator->m_points;
+}
+
+// Loads the triangulation from the cache file at path if from(points) made
+// it, otherwise triangulates them with from() and writes the cache. A cache
+// of a hull, a periodic triangulation or one with merged points isn't used.
+// Returns true if the cache was used; the cache is only written if from()
+// succeeded.
+bool Delaunator::from_cached(PackedVector2Array points, String path) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  const std::string file_path = to_file_path(path);
+
+  delaunator_cpp::CacheInfo info;
+  if (delaunator_cpp::read_cache_info(file_path, info) == delaunator_cpp::CacheStatus::OK &&
+      info.mode == delaunator_cpp::CacheMode::TRIANGULATION &&
+      info.tolerance == 0 &&
+      info.points_hash == delaunator_cpp::hash_points(points) &&
+      load(path) == OK) {
+    return true;
+  }
+
+  // from() swaps in a new triangulation only when it succeeds
+  const std::shared_ptr<delaunator_cpp::Delaunator> previous = delaunator;
+  from(points, 0);
+  if (delaunator != previous) {
+    save(path, false);
+  }
+  return false;
+}
+
+// Writes the triangulation to a binary cache file, with the circumcenters and
+// per-point adjacency too if include_derived is set.
+Error Delaunator::save(String path, bool include_derived) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  ERR_FAIL_COND_V_MSG(!delaunator, ERR_UNCONFIGURED, "Nothing has been triangulated.");
+
+  delaunator_cpp::CacheExtras extras;
+  if (!wrap_offsets.empty()) {
+    extras.mode = delaunator_cpp::CacheMode::PERIODIC;
+  } else if (delaunator->triangles.empty()) {
+    extras.mode = delaunator_cpp::CacheMode::HULL;
+  }
+  extras.tolerance = merge_tolerance;
+  extras.point_remap = point_remap;
+  extras.wrap_offsets = wrap_offsets;
+  extras.periodic_size = periodic_size;
+  if (include_derived) {
+    if (circumcenters.empty()) {
+      delaunator_cpp::circumcenters(*delaunator, circumcenters);
+    }
+    extras.circumcenters = circumcenters;
+    extras.inedges = get_inedges();
+  }
+  return to_error(delaunator_cpp::save_triangulation(to_file_path(path), *delaunator, extras));
+}
+
+// Replaces the triangulation with one from a cache file written by save(),
+// along with its merge tolerance, point remap and skipped points.
+Error Delaunator::load(String path) {
+
+  std::shared_ptr<delaunator_cpp::Delaunator> loaded = std::make_shared<delaunator_cpp::Delaunator>();
+  delaunator_cpp::CacheExtras extras;
+
+  Error error = to_error(delaunator_cpp::load_triangulation(to_file_path(path), *loaded, extras));
+  if (error != OK) {
+    return error;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  delaunator = std::move(loaded);
+  circumradii.clear();
+  point_remap = std::move(extras.point_remap);
+  merge_tolerance = extras.tolerance;
+  inedges = std::move(extras.inedges);
+  circumcenters = std::move(extras.circumcenters);
+  wrap_offsets = std::move(extras.wrap_offsets);
+  periodic_size = extras.periodic_size;
+  return OK;
+}
+
+const std::vector<std::size_t>& Delaunator::get_inedges() {
+
+  if (inedges.empty()) {
+    delaunator_cpp::build_inedges(*delaunator, inedges);
+  }
+  return inedges;
+}
+
+// The triangulation, to be changed in place. It's copied first if a
+// DelaunatorResult still holds it, since results never change.
+delaunator_cpp::Delaunator& Delaunator::unshared() {
+
+  if (delaunator.use_count() > 1) {
+    delaunator = std::make_shared<delaunator_cpp::Delaunator>(*delaunator);
+  }
+  return *delaunator;
+}
+
+// Returns the current triangulation as a DelaunatorResult, which stays as it
+// is whatever this Delaunator does next, so other threads can read it while
+// this one triangulates something else. Taking it doesn't copy anything.
+Ref<DelaunatorResult> Delaunator::get_result() {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  Ref<DelaunatorResult> result;
+  result.instantiate();
+  result->set_triangulation(delaunator, point_remap, wrap_offsets, periodic_size);
+  return result;
+}
+
+// For each point, the index of the point it was merged into or skipped as a
+// duplicate of, or its own index if it's triangulated.
+PackedInt32Array Delaunator::get_point_remap() {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  return point_remap_array(point_remap, delaunator ? delaunator->m_points.size() : 0);
+}
+
+// The points which aren't in any triangle, in ascending order.
+PackedInt32Array Delaunator::get_skipped_points() {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  return skipped_points_array(point_remap);
+}
+
+// Returns the boundary of the alpha shape as an Array of PackedInt32Array rings
+// of point indices. The circumradii are cached, so calling this again with a
+// different alpha only re-filters the triangles. alpha can't be negative.
+Array Delaunator::get_alpha_shape(double alpha) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  Array result;
+  ERR_FAIL_COND_V_MSG(!(alpha >= 0), result, "alpha must not be negative.");
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "get_alpha_shape() doesn't support periodic triangulations.");
+    if (circumradii.empty()) {
+      delaunator_cpp::circumradii(*delaunator, circumradii);
+    }
+
+    std::vector<std::vector<std::size_t>> loops = delaunator_cpp::alpha_shape(*delaunator, circumradii, alpha);
+    for(const std::vector<std::size_t>& loop : loops) {
+      result.push_back(to_packed_int32_array(loop));
+    }
+  }
+  return result;
+}
+
+// Interpolates the per-point values at each query point, using the
+// triangle containing it. Queries outside the hull give NaN.
+PackedFloat32Array Delaunator::interpolate_linear(PackedFloat32Array values, PackedVector2Array query_points) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  PackedFloat32Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "interpolate_linear() doesn't support periodic triangulations.");
+    ERR_FAIL_COND_V_MSG(values.size() != delaunator->m_points.size(), result, "values must have one entry per point.");
+
+    result.resize(query_points.size());
+    delaunator_cpp::interpolate_linear(*delaunator, values.ptr(), query_points.ptr(), query_points.size(), result.ptrw());
+  }
+  return result;
+}
+
+// As interpolate_linear() but with natural neighbor (Sibson) interpolation,
+// which is smooth across triangle edges.
+PackedFloat32Array Delaunator::interpolate_natural_neighbor(PackedFloat32Array values, PackedVector2Array query_points) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  PackedFloat32Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "interpolate_natural_neighbor() doesn't support periodic triangulations.");
+    ERR_FAIL_COND_V_MSG(values.size() != delaunator->m_points.size(), result, "values must have one entry per point.");
+
+    result.resize(query_points.size());
+    delaunator_cpp::interpolate_natural_neighbor(*delaunator, values.ptr(), query_points.ptr(), query_points.size(), result.ptrw());
+  }
+  return result;
+}
+
+// Returns a FORMAT_RF Image of the linearly interpolated values, with the
+// pixels covering rect. Pixels outside the hull are NaN.
+Ref<Image> Delaunator::rasterize(PackedFloat32Array values, Rect2 rect, Vector2i size) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  Ref<Image> result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "rasterize() doesn't support periodic triangulations.");
+    ERR_FAIL_COND_V_MSG(values.size() != delaunator->m_points.size(), result, "values must have one entry per point.");
+    ERR_FAIL_COND_V_MSG(size.x <= 0 || size.y <= 0, result, "size must be positive.");
+    ERR_FAIL_COND_V_MSG(!(rect.size.x > 0) || !(rect.size.y > 0), result, "rect must have a positive size.");
 
+    PackedByteArray pixels;
+    pixels.resize(static_cast<int64_t>(size.x) * size.y * sizeof(float));
+    delaunator_cpp::rasterize(*delaunator, values.ptr(), rect, size.x, size.y, reinterpret_cast<float *>(pixels.ptrw()));
+
+    result.instantiate();
+    result->set_data(size.x, size.y, false, Image::FORMAT_RF, pixels);
+  }
+  return result;
+}
+
+// Returns the arrays for ArrayMesh.add_surface_from_arrays() of the surface
+// with each point (x, y) lifted to (x, heights[i], y): vertices, smooth
+// normals and indices, plus UVs over the points' bounding box and tangents
+// if asked for.
+Array Delaunator::build_mesh(PackedFloat32Array heights, bool uvs, bool tangents) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(heights.size() != delaunator->m_points.size(), result, "heights must have one entry per point.");
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "build_mesh() doesn't support periodic triangulations.");
+
+    PackedVector3Array vertex_array;
+    PackedVector3Array normal_array;
+    PackedVector2Array uv_array;
+    PackedFloat32Array tangent_array;
+    PackedInt32Array index_array;
+    vertex_array.resize(heights.size());
+    normal_array.resize(heights.size());
+    if (uvs) uv_array.resize(heights.size());
+    if (tangents) tangent_array.resize(heights.size() * 4);
+    index_array.resize(delaunator->triangles.size());
+
+    delaunator_cpp::build_mesh(*delaunator, heights.ptr(),
+      vertex_array.ptrw(), normal_array.ptrw(),
+      uvs ? uv_array.ptrw() : nullptr,
+      tangents ? tangent_array.ptrw() : nullptr,
+      index_array.ptrw());
+
+    result.resize(Mesh::ARRAY_MAX);
+    result[Mesh::ARRAY_VERTEX] = vertex_array;
+    result[Mesh::ARRAY_NORMAL] = normal_array;
+    if (uvs) result[Mesh::ARRAY_TEX_UV] = uv_array;
+    if (tangents) result[Mesh::ARRAY_TANGENT] = tangent_array;
+    result[Mesh::ARRAY_INDEX] = index_array;
+  }
+  return result;
+}
+
+// Returns the edges of the Euclidean minimum spanning tree as a flat array
+// of point index pairs.
+PackedInt32Array Delaunator::get_minimum_spanning_tree() {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  PackedInt32Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "get_minimum_spanning_tree() doesn't support periodic triangulations.");
+    result = to_packed_int32_array(delaunator_cpp::minimum_spanning_tree(*delaunator));
+  }
+  return result;
+}
+
+// Returns a flat array of (point, nearest neighbor) index pairs.
+PackedInt32Array Delaunator::get_nearest_neighbors() {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  PackedInt32Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "get_nearest_neighbors() doesn't support periodic triangulations.");
+    result = to_packed_int32_array(delaunator_cpp::nearest_neighbors(*delaunator));
+  }
+  return result;
+}
+
+// Returns the point indices of the shortest path along the triangle edges
+// from from_point to to_point, or an empty array if there isn't one.
+PackedInt32Array Delaunator::find_path(int from_point, int to_point) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   PackedInt32Array result;
 
   if(delaunator) {
-    std::size_t size = delaunator->triangles.size();
-    result.resize(size);
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "find_path() doesn't support periodic triangulations.");
+    ERR_FAIL_INDEX_V(from_point, delaunator->m_points.size(), result);
+    ERR_FAIL_INDEX_V(to_point, delaunator->m_points.size(), result);
+
+    result = to_packed_int32_array(delaunator_cpp::find_path(*delaunator, get_inedges(), from_point, to_point));
+  }
+  return result;
+}
+
+// Batched find_path(), returning an Array with the path from from_points[i]
+// to to_points[i] at index i. Each pair is searched separately, in parallel;
+// find_nearest_paths() is one search for many sources.
+Array Delaunator::find_paths(PackedInt32Array from_points, PackedInt32Array to_points) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "find_paths() doesn't support periodic triangulations.");
+    ERR_FAIL_COND_V_MSG(from_points.size() != to_points.size(), result, "from_points and to_points must be the same size.");
+
+    // out of range indices become paths that can't be found
+    std::vector<std::size_t> from(from_points.ptr(), from_points.ptr() + from_points.size());
+    std::vector<std::size_t> to(to_points.ptr(), to_points.ptr() + to_points.size());
 
-    for(std::size_t i = 0; i < size; i++) {
-      result.set(i, delaunator->triangles[i]);
+    std::vector<std::vector<std::size_t>> paths = delaunator_cpp::find_paths(*delaunator, get_inedges(), from, to);
+    for(const std::vector<std::size_t>& path : paths) {
+      result.push_back(to_packed_int32_array(path));
     }
   }
   return result;
 }
 
+// Returns an Array with the shortest path to to_points[i] from whichever of
+// from_points is nearest to it along the triangle edges, at index i, found
+// with a single search from all of from_points at once. Points that can't
+// be reached get an empty array.
+Array Delaunator::find_nearest_paths(PackedInt32Array from_points, PackedInt32Array to_points) {
 
-PackedInt32Array Delaunator::get_halfedges() {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "find_nearest_paths() doesn't support periodic triangulations.");
+    // out of range indices are left out of the search
+    std::vector<std::size_t> from(from_points.ptr(), from_points.ptr() + from_points.size());
+    std::vector<std::size_t> to(to_points.ptr(), to_points.ptr() + to_points.size());
+
+    std::vector<std::vector<std::size_t>> paths = delaunator_cpp::find_nearest_paths(*delaunator, get_inedges(), from, to);
+    for(const std::vector<std::size_t>& path : paths) {
+      result.push_back(to_packed_int32_array(path));
+    }
+  }
+  return result;
+}
+
+// Returns the triangles reachable from seed_triangle without crossing the
+// hull or a blocked edge, in breadth first order. edge_mask has an entry per
+// halfedge, and an edge is blocked when either of its halfedges' entries is
+// 0; an empty mask blocks nothing.
+PackedInt32Array Delaunator::flood_fill(int seed_triangle, PackedByteArray edge_mask) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  PackedInt32Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!edge_mask.is_empty() && static_cast<std::size_t>(edge_mask.size()) != delaunator->halfedges.size(), result, "edge_mask must be empty or have one entry per halfedge.");
+    ERR_FAIL_INDEX_V(seed_triangle, delaunator->triangles.size() / 3, result);
 
+    result = to_packed_int32_array(delaunator_cpp::flood_fill(*delaunator, seed_triangle, edge_mask.is_empty() ? nullptr : edge_mask.ptr()));
+  }
+  return result;
+}
+
+// Labels each triangle with its connected component, as split by the
+// blocked edges of edge_mask (see flood_fill()). Components are numbered
+// from 0 in order of their lowest triangle.
+PackedInt32Array Delaunator::get_connected_components(PackedByteArray edge_mask) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   PackedInt32Array result;
 
   if(delaunator) {
-    std::size_t size = delaunator->halfedges.size();
-    result.resize(size);
+    ERR_FAIL_COND_V_MSG(!edge_mask.is_empty() && static_cast<std::size_t>(edge_mask.size()) != delaunator->halfedges.size(), result, "edge_mask must be empty or have one entry per halfedge.");
 
-    for(std::size_t i = 0; i < size; i++) {
-      result.set(i, delaunator->halfedges[i]);
+    std::size_t count;
+    result = to_packed_int32_array(delaunator_cpp::connected_components(*delaunator, edge_mask.is_empty() ? nullptr : edge_mask.ptr(), count));
+  }
+  return result;
+}
+
+// Returns the contour lines at level of the linearly interpolated per-point
+// values, as an Array of PackedVector2Array, with the higher values on the
+// left of each line. Closed lines end with their first point repeated.
+Array Delaunator::get_contours(PackedFloat32Array values, float level) {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(values.size() != delaunator->m_points.size(), result, "values must have one entry per point.");
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "get_contours() doesn't support periodic triangulations.");
+
+    std::vector<std::vector<Vector2>> lines = delaunator_cpp::contours(*delaunator, values.ptr(), level);
+    for(const std::vector<Vector2>& line : lines) {
+      PackedVector2Array packed;
+      packed.resize(line.size());
+      std::copy(line.begin(), line.end(), packed.ptrw());
+      result.push_back(packed);
     }
   }
   return result;
 }
 
+// Checks the triangulation with exact arithmetic (see
+// delaunator_cpp::validate()), returning a description of the first problem
+// found, or an empty String if it's a valid Delaunay triangulation.
+String Delaunator::validate() {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  ERR_FAIL_COND_V_MSG(!delaunator, String("no triangulation"), "nothing has been triangulated.");
+  ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), String("periodic"), "validate() doesn't support periodic triangulations.");
+
+  return String(delaunator_cpp::validate(*delaunator, point_remap).c_str());
+}
+
+// Sets how many threads the parallel paths of every Delaunator and
+// DelaunatorTileSet use, counting the calling thread; 0 restores the default
+// of one per hardware thread.
+void Delaunator::set_worker_count(int count) {
+
+  ERR_FAIL_COND_MSG(count < 0, "count must not be negative.");
+  delaunator_cpp::set_worker_count(static_cast<std::size_t>(count));
+}
+
+int Delaunator::get_worker_count() {
+  return static_cast<int>(delaunator_cpp::worker_count());
+}
+
+PackedInt32Array Delaunator::get_triangles() {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  PackedInt32Array result;
+
+  if(delaunator) {
+    result = to_packed_int32_array(delaunator->triangles);
+  }
+  return result;
+}
+
+
+PackedInt32Array Delaunator::get_halfedges() {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  PackedInt32Array result;
+
+  if(delaunator) {
+    result = to_packed_int32_array(delaunator->halfedges);
+  }
+  return result;
+}
+
 PackedInt32Array Delaunator::get_hull() {
 
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   PackedInt32Array result;
 
   if(delaunator) {
+    result = hull_array(*delaunator);
+  }
+  return result;
+}
+
+// Returns, for each halfedge of a periodic triangulation, the offset to add to
+// the position of its point to give that point's position in the halfedge's
+// triangle. Empty for triangulations made by from().
+PackedVector2Array Delaunator::get_wrap_offsets() {
 
-    size_t e = delaunator->hull_start;
-    do {
-      result.push_back(static_cast<int32_t>(e));
-      e = delaunator->hull_next[e];
-    } while (e != delaunator->hull_start);
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  return wrap_offsets_array(wrap_offsets, periodic_size);
+}
+
+// Returns the circumcenter of each triangle, which are the vertices of the
+// Voronoi diagram.
+PackedVector2Array Delaunator::get_circumcenters() {
+
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  PackedVector2Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "get_circumcenters() doesn't support periodic triangulations.");
+    if (circumcenters.empty()) {
+      delaunator_cpp::circumcenters(*delaunator, circumcenters);
+    }
+    result.resize(circumcenters.size());
+    std::copy(circumcenters.begin(), circumcenters.end(), result.ptrw());
   }
   return result;
 }
 
 float Delaunator::get_hull_area() {
 
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   PackedInt32Array result;
 
   if(delaunator) {
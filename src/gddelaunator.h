@@ -7,8 +7,17 @@
 #include <windows.h>
 #endif
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <godot_cpp/classes/global_constants.hpp>
+#include <godot_cpp/classes/image.hpp>
 #include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
 #include "delaunator.hpp"
+#include "gddelaunator_result.h"
 
 using namespace godot;
 
@@ -20,7 +29,31 @@ protected:
 	static void _bind_methods();
 
 private:
-	delaunator_cpp::Delaunator *delaunator;
+	// Every method holds the mutex, so one thread's from() can't replace the
+	// triangulation under another thread's reads. The triangulation itself is
+	// shared with any DelaunatorResult taken from it, and copied before it's
+	// changed in place if one still holds it.
+	std::recursive_mutex mutex;
+	std::shared_ptr<delaunator_cpp::Delaunator> delaunator;
+
+	// Squared circumradius of each triangle, calculated on first use
+	std::vector<double> circumradii;
+	// A halfedge ending at each point, calculated on first use
+	std::vector<std::size_t> inedges;
+	// Circumcenter of each triangle, calculated on first use
+	std::vector<Vector2> circumcenters;
+
+	// For each point, the point it was merged into or skipped as a duplicate
+	// of; empty when every point was triangulated
+	std::vector<std::size_t> point_remap;
+	double merge_tolerance = 0;
+
+	// For periodic triangulations, the wrap of each halfedge's point
+	std::vector<Vector2i> wrap_offsets;
+	Vector2 periodic_size;
+
+	const std::vector<std::size_t>& get_inedges();
+	delaunator_cpp::Delaunator& unshared();
 
 public:
 
@@ -32,12 +65,41 @@ public:
 	};
 
 	// Functions
-	void from(PackedVector2Array points);
+	void from(PackedVector2Array points, double tolerance);
+	void from_periodic(PackedVector2Array points, Rect2 domain);
+	void compute_hull(PackedVector2Array points);
+	bool update_positions(PackedVector2Array points, double max_flip_fraction);
+	PackedVector2Array relax(PackedVector2Array points, int iterations, Rect2 bounds);
+	bool from_cached(PackedVector2Array points, String path);
+	Error save(String path, bool include_derived);
+	Error load(String path);
+	Ref<DelaunatorResult> get_result();
+	PackedInt32Array get_point_remap();
+	PackedInt32Array get_skipped_points();
+	Array get_alpha_shape(double alpha);
+	PackedFloat32Array interpolate_linear(PackedFloat32Array values, PackedVector2Array query_points);
+	PackedFloat32Array interpolate_natural_neighbor(PackedFloat32Array values, PackedVector2Array query_points);
+	Ref<Image> rasterize(PackedFloat32Array values, Rect2 rect, Vector2i size);
+	Array build_mesh(PackedFloat32Array heights, bool uvs, bool tangents);
+	PackedInt32Array get_minimum_spanning_tree();
+	PackedInt32Array get_nearest_neighbors();
+	PackedInt32Array find_path(int from_point, int to_point);
+	Array find_paths(PackedInt32Array from_points, PackedInt32Array to_points);
+	Array find_nearest_paths(PackedInt32Array from_points, PackedInt32Array to_points);
+	PackedInt32Array flood_fill(int seed_triangle, PackedByteArray edge_mask);
+	PackedInt32Array get_connected_components(PackedByteArray edge_mask);
+	Array get_contours(PackedFloat32Array values, float level);
+	String validate();
+
+	static void set_worker_count(int count);
+	static int get_worker_count();
 
 	// Properties
 	PackedInt32Array get_triangles();
 	PackedInt32Array get_halfedges();
 	PackedInt32Array get_hull();
+	PackedVector2Array get_wrap_offsets();
+	PackedVector2Array get_circumcenters();
 	float get_hull_area();
 	String get_compile_time();
 };
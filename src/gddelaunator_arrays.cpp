@@ -0,0 +1,63 @@
+#include "gddelaunator_arrays.h"
+
+using namespace godot;
+
+PackedInt32Array to_packed_int32_array(const std::vector<std::size_t>& indices) {
+
+  PackedInt32Array result;
+  result.resize(indices.size());
+  int32_t *result_ptr = result.ptrw();
+  for(std::size_t i = 0; i < indices.size(); i++) {
+    result_ptr[i] = static_cast<int32_t>(indices[i]);
+  }
+  return result;
+}
+
+PackedInt32Array hull_array(const delaunator_cpp::Delaunator& delaunator) {
+
+  PackedInt32Array result;
+
+  if(delaunator.hull_start != delaunator_cpp::INVALID_INDEX) {
+
+    size_t e = delaunator.hull_start;
+    do {
+      result.push_back(static_cast<int32_t>(e));
+      e = delaunator.hull_next[e];
+    } while (e != delaunator.hull_start);
+  }
+  return result;
+}
+
+PackedInt32Array point_remap_array(const std::vector<std::size_t>& point_remap, std::size_t point_count) {
+
+  if (point_remap.empty()) {
+    PackedInt32Array result;
+    result.resize(point_count);
+    int32_t *result_ptr = result.ptrw();
+    for(int64_t i = 0; i < result.size(); i++) {
+      result_ptr[i] = static_cast<int32_t>(i);
+    }
+    return result;
+  }
+  return to_packed_int32_array(point_remap);
+}
+
+PackedInt32Array skipped_points_array(const std::vector<std::size_t>& point_remap) {
+
+  std::vector<std::size_t> skipped;
+  for(std::size_t i = 0; i < point_remap.size(); i++) {
+    if (point_remap[i] != i) skipped.push_back(i);
+  }
+  return to_packed_int32_array(skipped);
+}
+
+PackedVector2Array wrap_offsets_array(const std::vector<Vector2i>& wrap_offsets, Vector2 periodic_size) {
+
+  PackedVector2Array result;
+  result.resize(wrap_offsets.size());
+  Vector2 *result_ptr = result.ptrw();
+  for(std::size_t i = 0; i < wrap_offsets.size(); i++) {
+    result_ptr[i] = Vector2(wrap_offsets[i].x * periodic_size.x, wrap_offsets[i].y * periodic_size.y);
+  }
+  return result;
+}
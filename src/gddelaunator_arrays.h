@@ -0,0 +1,34 @@
+#ifndef GDDELAUNATOR_ARRAYS_H
+#define GDDELAUNATOR_ARRAYS_H
+
+#include <cstddef>
+#include <vector>
+
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+#include "delaunator.hpp"
+
+using namespace godot;
+
+
+// The arrays Delaunator and DelaunatorResult both hand out, built the same
+// way for each.
+
+PackedInt32Array to_packed_int32_array(const std::vector<std::size_t>& indices);
+
+// The hull's points in order, or nothing if there's no hull.
+PackedInt32Array hull_array(const delaunator_cpp::Delaunator& delaunator);
+
+// The point each of point_count points was merged into; an empty
+// point_remap means every point was kept.
+PackedInt32Array point_remap_array(const std::vector<std::size_t>& point_remap, std::size_t point_count);
+
+// The points which aren't in any triangle, in ascending order.
+PackedInt32Array skipped_points_array(const std::vector<std::size_t>& point_remap);
+
+// Each halfedge's wrap offset as a shift in the domain's units.
+PackedVector2Array wrap_offsets_array(const std::vector<Vector2i>& wrap_offsets, Vector2 periodic_size);
+
+#endif // ! GDDELAUNATOR_ARRAYS_H
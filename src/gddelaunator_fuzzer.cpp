@@ -0,0 +1,194 @@
+#include "gddelaunator_fuzzer.h"
+
+#ifdef DEBUG_ENABLED
+
+#include <algorithm>
+#include <string>
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+using namespace godot;
+
+static const char *kind_name(delaunator_cpp::FuzzFailureKind kind) {
+
+  switch (kind) {
+    case delaunator_cpp::FuzzFailureKind::INVALID: return "invalid";
+    case delaunator_cpp::FuzzFailureKind::SLOW: return "slow";
+    case delaunator_cpp::FuzzFailureKind::HANG: return "hang";
+  }
+  return "";
+}
+
+void DelaunatorFuzzer::_bind_methods() {
+
+  // Functions
+	ClassDB::bind_method(D_METHOD("run"), &DelaunatorFuzzer::run);
+	ClassDB::bind_static_method("DelaunatorFuzzer", D_METHOD("check", "points"), &DelaunatorFuzzer::check);
+	ClassDB::bind_static_method("DelaunatorFuzzer", D_METHOD("check_regressions"), &DelaunatorFuzzer::check_regressions);
+	ClassDB::bind_static_method("DelaunatorFuzzer", D_METHOD("generate", "generator", "case_seed", "count"), &DelaunatorFuzzer::generate);
+	ClassDB::bind_static_method("DelaunatorFuzzer", D_METHOD("get_generators"), &DelaunatorFuzzer::get_generators);
+
+  // Properties
+	ClassDB::bind_method(D_METHOD("set_seed", "seed"), &DelaunatorFuzzer::set_seed);
+	ClassDB::bind_method(D_METHOD("get_seed"), &DelaunatorFuzzer::get_seed);
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+
+	ClassDB::bind_method(D_METHOD("set_duration", "duration"), &DelaunatorFuzzer::set_duration);
+	ClassDB::bind_method(D_METHOD("get_duration"), &DelaunatorFuzzer::get_duration);
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "duration"), "set_duration", "get_duration");
+
+	ClassDB::bind_method(D_METHOD("set_max_points", "max_points"), &DelaunatorFuzzer::set_max_points);
+	ClassDB::bind_method(D_METHOD("get_max_points"), &DelaunatorFuzzer::get_max_points);
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_points"), "set_max_points", "get_max_points");
+
+	ClassDB::bind_method(D_METHOD("set_microseconds_per_point", "microseconds_per_point"), &DelaunatorFuzzer::set_microseconds_per_point);
+	ClassDB::bind_method(D_METHOD("get_microseconds_per_point"), &DelaunatorFuzzer::get_microseconds_per_point);
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "microseconds_per_point"), "set_microseconds_per_point", "get_microseconds_per_point");
+
+	ClassDB::bind_method(D_METHOD("set_hang_time", "hang_time"), &DelaunatorFuzzer::set_hang_time);
+	ClassDB::bind_method(D_METHOD("get_hang_time"), &DelaunatorFuzzer::get_hang_time);
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "hang_time"), "set_hang_time", "get_hang_time");
+
+	ClassDB::bind_method(D_METHOD("set_verbose", "verbose"), &DelaunatorFuzzer::set_verbose);
+	ClassDB::bind_method(D_METHOD("get_verbose"), &DelaunatorFuzzer::get_verbose);
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "verbose"), "set_verbose", "get_verbose");
+
+	ClassDB::bind_method(D_METHOD("get_cases_run"), &DelaunatorFuzzer::get_cases_run);
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "cases_run"), NULL, "get_cases_run");
+}
+
+// Generates and checks cases for 'duration' seconds, returning a Dictionary
+// for each failure with its "kind" ("invalid", "slow" or "hang"), the
+// "generator", "case_seed" and "original_size" which reproduce it with
+// generate(), the "message", the minimized "points" and the sweep's "msec".
+// With 'verbose' set, each case is printed before it runs, so the last line
+// printed names the case if one crashes.
+Array DelaunatorFuzzer::run() {
+
+  delaunator_cpp::FuzzOptions run_options = options;
+  if(verbose) {
+    run_options.on_case = [](const std::string& generator, std::uint64_t case_seed, std::size_t count) {
+      UtilityFunctions::print(String("DelaunatorFuzzer: ") + String(generator.c_str()) + " case_seed " +
+          String::num_int64(static_cast<int64_t>(case_seed)) + ", " + String::num_int64(static_cast<int64_t>(count)) + " points");
+    };
+  }
+  delaunator_cpp::FuzzReport report = delaunator_cpp::fuzz(run_options);
+  cases_run = static_cast<int>(report.cases);
+
+  Array result;
+  for(const delaunator_cpp::FuzzFailure& failure : report.failures) {
+    Dictionary entry;
+    entry["kind"] = String(kind_name(failure.kind));
+    entry["generator"] = String(failure.generator.c_str());
+    entry["case_seed"] = static_cast<int64_t>(failure.case_seed);
+    entry["original_size"] = static_cast<int64_t>(failure.original_size);
+    entry["message"] = String(failure.message.c_str());
+    entry["points"] = failure.points;
+    entry["msec"] = failure.milliseconds;
+    result.push_back(entry);
+  }
+  return result;
+}
+
+// Triangulates the points and validates the result, as each fuzzed case is;
+// returns what's wrong, or an empty String. For replaying failures.
+String DelaunatorFuzzer::check(PackedVector2Array points) {
+  return String(delaunator_cpp::check_points(points).c_str());
+}
+
+// Replays the fixed cases for bugs found so far; see
+// delaunator_cpp::check_regressions(). Returns "name: problem" for each
+// which fails.
+PackedStringArray DelaunatorFuzzer::check_regressions() {
+
+  PackedStringArray result;
+  for(const std::string& failure : delaunator_cpp::check_regressions()) {
+    result.push_back(String(failure.c_str()));
+  }
+  return result;
+}
+
+// The points of a fuzzed case, from the "generator", "case_seed" and
+// "original_size" of a failure.
+PackedVector2Array DelaunatorFuzzer::generate(String generator, int64_t case_seed, int count) {
+
+  PackedVector2Array result;
+  const std::vector<std::string>& generators = delaunator_cpp::fuzz_generators();
+  const auto found = std::find(generators.begin(), generators.end(), std::string(generator.utf8().get_data()));
+  ERR_FAIL_COND_V_MSG(found == generators.end(), result, "unknown generator.");
+  ERR_FAIL_COND_V_MSG(count < 3, result, "count must be at least 3.");
+
+  result = delaunator_cpp::fuzz_points(found - generators.begin(), static_cast<std::uint64_t>(case_seed), static_cast<std::size_t>(count));
+  return result;
+}
+
+PackedStringArray DelaunatorFuzzer::get_generators() {
+
+  PackedStringArray result;
+  for(const std::string& generator : delaunator_cpp::fuzz_generators()) {
+    result.push_back(String(generator.c_str()));
+  }
+  return result;
+}
+
+void DelaunatorFuzzer::set_seed(int64_t seed) {
+  options.seed = static_cast<std::uint64_t>(seed);
+}
+
+int64_t DelaunatorFuzzer::get_seed() {
+  return static_cast<int64_t>(options.seed);
+}
+
+void DelaunatorFuzzer::set_duration(double duration) {
+  options.seconds = duration;
+}
+
+double DelaunatorFuzzer::get_duration() {
+  return options.seconds;
+}
+
+void DelaunatorFuzzer::set_max_points(int max_points) {
+
+  ERR_FAIL_COND_MSG(max_points < 3, "max_points must be at least 3.");
+  options.max_points = static_cast<std::size_t>(max_points);
+}
+
+int DelaunatorFuzzer::get_max_points() {
+  return static_cast<int>(options.max_points);
+}
+
+void DelaunatorFuzzer::set_microseconds_per_point(double microseconds_per_point) {
+  options.microseconds_per_point = microseconds_per_point;
+}
+
+double DelaunatorFuzzer::get_microseconds_per_point() {
+  return options.microseconds_per_point;
+}
+
+void DelaunatorFuzzer::set_hang_time(double hang_time) {
+
+  ERR_FAIL_COND_MSG(hang_time <= 0, "hang_time must be positive.");
+  options.hang_seconds = hang_time;
+}
+
+double DelaunatorFuzzer::get_hang_time() {
+  return options.hang_seconds;
+}
+
+void DelaunatorFuzzer::set_verbose(bool p_verbose) {
+  verbose = p_verbose;
+}
+
+bool DelaunatorFuzzer::get_verbose() {
+  return verbose;
+}
+
+// The number of cases the last run() checked.
+int DelaunatorFuzzer::get_cases_run() {
+  return cases_run;
+}
+
+#endif // DEBUG_ENABLED
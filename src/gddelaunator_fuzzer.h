@@ -0,0 +1,62 @@
+#ifndef GDDELAUNATOR_FUZZER_CLASS_H
+#define GDDELAUNATOR_FUZZER_CLASS_H
+
+// Only in debug builds, like the fuzzer itself.
+#ifdef DEBUG_ENABLED
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include "fuzz.hpp"
+
+using namespace godot;
+
+
+// Runs the triangulation on adversarial point sets and checks the results;
+// see delaunator_cpp::fuzz(). demo/fuzz.gd runs it headlessly against a
+// debug build, exiting with status 1 if a case was invalid or hung, as CI
+// does:
+//
+//   godot --headless --path demo -s fuzz.gd
+class DelaunatorFuzzer : public RefCounted {
+	GDCLASS(DelaunatorFuzzer, RefCounted);
+
+protected:
+	static void _bind_methods();
+
+private:
+	delaunator_cpp::FuzzOptions options;
+	bool verbose = false;
+	int cases_run = 0;
+
+public:
+
+	// Functions
+	Array run();
+	static String check(PackedVector2Array points);
+	static PackedStringArray check_regressions();
+	static PackedVector2Array generate(String generator, int64_t case_seed, int count);
+	static PackedStringArray get_generators();
+
+	// Properties
+	void set_seed(int64_t seed);
+	int64_t get_seed();
+	void set_duration(double duration);
+	double get_duration();
+	void set_max_points(int max_points);
+	int get_max_points();
+	void set_microseconds_per_point(double microseconds_per_point);
+	double get_microseconds_per_point();
+	void set_hang_time(double hang_time);
+	double get_hang_time();
+	void set_verbose(bool p_verbose);
+	bool get_verbose();
+	int get_cases_run();
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // ! GDDELAUNATOR_FUZZER_CLASS_H
@@ -0,0 +1,139 @@
+#include "gddelaunator_result.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/error_macros.hpp>
+
+#include "gddelaunator_arrays.h"
+#include "voronoi.hpp"
+
+using namespace godot;
+
+void DelaunatorResult::_bind_methods() {
+
+  // Functions
+	ClassDB::bind_method(D_METHOD("get_point_remap"), &DelaunatorResult::get_point_remap);
+	ClassDB::bind_method(D_METHOD("get_skipped_points"), &DelaunatorResult::get_skipped_points);
+
+  // Properties
+	ClassDB::bind_method(D_METHOD("get_points"), &DelaunatorResult::get_points);
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_VECTOR2_ARRAY, "points"), NULL, "get_points");
+
+	ClassDB::bind_method(D_METHOD("get_triangles"), &DelaunatorResult::get_triangles);
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_INT32_ARRAY, "triangles"), NULL, "get_triangles");
+
+	ClassDB::bind_method(D_METHOD("get_halfedges"), &DelaunatorResult::get_halfedges);
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_INT32_ARRAY, "halfedges"), NULL, "get_halfedges");
+
+	ClassDB::bind_method(D_METHOD("get_hull"), &DelaunatorResult::get_hull);
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_INT32_ARRAY, "hull"), NULL, "get_hull");
+
+	ClassDB::bind_method(D_METHOD("get_wrap_offsets"), &DelaunatorResult::get_wrap_offsets);
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_VECTOR2_ARRAY, "wrap_offsets"), NULL, "get_wrap_offsets");
+
+	ClassDB::bind_method(D_METHOD("get_circumcenters"), &DelaunatorResult::get_circumcenters);
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_VECTOR2_ARRAY, "circumcenters"), NULL, "get_circumcenters");
+
+	ClassDB::bind_method(D_METHOD("get_hull_area"), &DelaunatorResult::get_hull_area);
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "hull_area"), NULL, "get_hull_area");
+}
+
+// Called by Delaunator.get_result() before the result is handed out, so
+// nothing else can be reading it yet.
+void DelaunatorResult::set_triangulation(
+    std::shared_ptr<const delaunator_cpp::Delaunator> p_delaunator,
+    std::vector<std::size_t> p_point_remap,
+    std::vector<Vector2i> p_wrap_offsets,
+    Vector2 p_periodic_size) {
+
+  delaunator = std::move(p_delaunator);
+  point_remap = std::move(p_point_remap);
+  wrap_offsets = std::move(p_wrap_offsets);
+  periodic_size = p_periodic_size;
+}
+
+// As Delaunator.get_point_remap().
+PackedInt32Array DelaunatorResult::get_point_remap() {
+
+  return point_remap_array(point_remap, delaunator ? delaunator->m_points.size() : 0);
+}
+
+// As Delaunator.get_skipped_points().
+PackedInt32Array DelaunatorResult::get_skipped_points() {
+
+  return skipped_points_array(point_remap);
+}
+
+PackedVector2Array DelaunatorResult::get_points() {
+
+  PackedVector2Array result;
+
+  if(delaunator) {
+    result = delaunator->m_points;
+  }
+  return result;
+}
+
+PackedInt32Array DelaunatorResult::get_triangles() {
+
+  PackedInt32Array result;
+
+  if(delaunator) {
+    result = to_packed_int32_array(delaunator->triangles);
+  }
+  return result;
+}
+
+PackedInt32Array DelaunatorResult::get_halfedges() {
+
+  PackedInt32Array result;
+
+  if(delaunator) {
+    result = to_packed_int32_array(delaunator->halfedges);
+  }
+  return result;
+}
+
+PackedInt32Array DelaunatorResult::get_hull() {
+
+  PackedInt32Array result;
+
+  if(delaunator) {
+    result = hull_array(*delaunator);
+  }
+  return result;
+}
+
+// As Delaunator.get_wrap_offsets().
+PackedVector2Array DelaunatorResult::get_wrap_offsets() {
+
+  return wrap_offsets_array(wrap_offsets, periodic_size);
+}
+
+// Returns the circumcenter of each triangle, calculating them on the first
+// call from any thread.
+PackedVector2Array DelaunatorResult::get_circumcenters() {
+
+  PackedVector2Array result;
+
+  if(delaunator) {
+    ERR_FAIL_COND_V_MSG(!wrap_offsets.empty(), result, "get_circumcenters() doesn't support periodic triangulations.");
+    std::lock_guard<std::mutex> lock(mutex);
+    if (circumcenters.empty()) {
+      delaunator_cpp::circumcenters(*delaunator, circumcenters);
+    }
+    result.resize(circumcenters.size());
+    std::copy(circumcenters.begin(), circumcenters.end(), result.ptrw());
+  }
+  return result;
+}
+
+float DelaunatorResult::get_hull_area() {
+
+  if(delaunator) {
+    return static_cast<float>(delaunator->get_hull_area());
+  }
+  return std::numeric_limits<float>::quiet_NaN();
+}
@@ -0,0 +1,61 @@
+#ifndef GDDELAUNATOR_RESULT_CLASS_H
+#define GDDELAUNATOR_RESULT_CLASS_H
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+#include "delaunator.hpp"
+
+using namespace godot;
+
+
+// A triangulation taken from Delaunator.get_result(), which never changes.
+// It can be read from any thread, including while the Delaunator it came
+// from triangulates something else.
+class DelaunatorResult : public RefCounted {
+	GDCLASS(DelaunatorResult, RefCounted);
+
+protected:
+	static void _bind_methods();
+
+private:
+	// Shared with the Delaunator until it next changes its triangulation
+	std::shared_ptr<const delaunator_cpp::Delaunator> delaunator;
+	std::vector<std::size_t> point_remap;
+	std::vector<Vector2i> wrap_offsets;
+	Vector2 periodic_size;
+
+	// Guards the circumcenters, which are calculated on first use
+	std::mutex mutex;
+	std::vector<Vector2> circumcenters;
+
+public:
+
+	void set_triangulation(
+		std::shared_ptr<const delaunator_cpp::Delaunator> p_delaunator,
+		std::vector<std::size_t> p_point_remap,
+		std::vector<Vector2i> p_wrap_offsets,
+		Vector2 p_periodic_size);
+
+	// Functions
+	PackedInt32Array get_point_remap();
+	PackedInt32Array get_skipped_points();
+
+	// Properties
+	PackedVector2Array get_points();
+	PackedInt32Array get_triangles();
+	PackedInt32Array get_halfedges();
+	PackedInt32Array get_hull();
+	PackedVector2Array get_wrap_offsets();
+	PackedVector2Array get_circumcenters();
+	float get_hull_area();
+};
+
+#endif // ! GDDELAUNATOR_RESULT_CLASS_H
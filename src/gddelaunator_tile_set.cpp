@@ -0,0 +1,143 @@
+#include "gddelaunator_tile_set.h"
+
+#include <vector>
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/error_macros.hpp>
+
+#include "gddelaunator_arrays.h"
+
+using namespace godot;
+
+static bool points_inside(const Rect2& rect, const PackedVector2Array& points) {
+
+  const Vector2 *points_ptr = points.ptr();
+  for(int64_t i = 0; i < points.size(); i++) {
+    const Vector2& p = points_ptr[i];
+    if(p.x < rect.position.x || p.y < rect.position.y ||
+       p.x >= rect.position.x + rect.size.x || p.y >= rect.position.y + rect.size.y) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void DelaunatorTileSet::_bind_methods() {
+
+  // Functions
+	ClassDB::bind_method(D_METHOD("load_tile", "tile", "points"), &DelaunatorTileSet::load_tile);
+	ClassDB::bind_method(D_METHOD("load_tiles", "tiles", "points"), &DelaunatorTileSet::load_tiles);
+	ClassDB::bind_method(D_METHOD("unload_tile", "tile"), &DelaunatorTileSet::unload_tile);
+	ClassDB::bind_method(D_METHOD("has_tile", "tile"), &DelaunatorTileSet::has_tile);
+	ClassDB::bind_method(D_METHOD("get_loaded_tiles"), &DelaunatorTileSet::get_loaded_tiles);
+	ClassDB::bind_method(D_METHOD("get_tile_rect", "tile"), &DelaunatorTileSet::get_tile_rect);
+	ClassDB::bind_method(D_METHOD("get_tile_vertices", "tile"), &DelaunatorTileSet::get_tile_vertices);
+	ClassDB::bind_method(D_METHOD("get_tile_triangles", "tile"), &DelaunatorTileSet::get_tile_triangles);
+
+  // Properties
+	ClassDB::bind_method(D_METHOD("set_tile_size", "tile_size"), &DelaunatorTileSet::set_tile_size);
+	ClassDB::bind_method(D_METHOD("get_tile_size"), &DelaunatorTileSet::get_tile_size);
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tile_size"), "set_tile_size", "get_tile_size");
+}
+
+DelaunatorTileSet::DelaunatorTileSet() {
+  tile_set = new delaunator_cpp::TileSet(256.0);
+}
+
+DelaunatorTileSet::~DelaunatorTileSet() {
+  if (tile_set) delete(tile_set);
+  tile_set = NULL;
+}
+
+// Triangulates the tile's points, which must lie inside get_tile_rect(tile),
+// and stitches it to the loaded tiles around it. Replaces the tile if it's
+// already loaded.
+void DelaunatorTileSet::load_tile(Vector2i tile, PackedVector2Array points) {
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ERR_FAIL_COND_MSG(!points_inside(tile_set->get_tile_rect(tile), points), "points must lie inside the tile.");
+  tile_set->load_tiles({ tile }, { points });
+}
+
+// As load_tile() for each tile (Vector2i) and its PackedVector2Array of
+// points, with the tiles triangulated in parallel.
+void DelaunatorTileSet::load_tiles(Array tiles, Array points) {
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ERR_FAIL_COND_MSG(tiles.size() != points.size(), "tiles and points must be the same size.");
+
+  std::vector<Vector2i> keys(tiles.size());
+  std::vector<PackedVector2Array> tile_points(tiles.size());
+  for(int64_t i = 0; i < tiles.size(); i++) {
+    keys[i] = tiles[i];
+    tile_points[i] = points[i];
+    ERR_FAIL_COND_MSG(!points_inside(tile_set->get_tile_rect(keys[i]), tile_points[i]), "points must lie inside their tile.");
+  }
+  tile_set->load_tiles(keys, tile_points);
+}
+
+void DelaunatorTileSet::unload_tile(Vector2i tile) {
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if(tile_set->get_tile(tile)) {
+    tile_set->unload_tiles({ tile });
+  }
+}
+
+bool DelaunatorTileSet::has_tile(Vector2i tile) {
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return tile_set->get_tile(tile) != NULL;
+}
+
+Array DelaunatorTileSet::get_loaded_tiles() {
+
+  std::lock_guard<std::mutex> lock(mutex);
+  Array result;
+  for(const Vector2i& tile : tile_set->get_loaded_tiles()) {
+    result.push_back(tile);
+  }
+  return result;
+}
+
+Rect2 DelaunatorTileSet::get_tile_rect(Vector2i tile) {
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return tile_set->get_tile_rect(tile);
+}
+
+// The tile's own points, followed by the points of neighbouring tiles which
+// its seam triangles use.
+PackedVector2Array DelaunatorTileSet::get_tile_vertices(Vector2i tile) {
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const delaunator_cpp::TileSet::Tile *loaded = tile_set->get_tile(tile);
+  ERR_FAIL_COND_V_MSG(!loaded, PackedVector2Array(), "The tile isn't loaded.");
+  return loaded->vertices;
+}
+
+// The tile's triangles, as indices into get_tile_vertices(). Each triangle
+// of the whole triangulation is in exactly one loaded tile.
+PackedInt32Array DelaunatorTileSet::get_tile_triangles(Vector2i tile) {
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const delaunator_cpp::TileSet::Tile *loaded = tile_set->get_tile(tile);
+  ERR_FAIL_COND_V_MSG(!loaded, PackedInt32Array(), "The tile isn't loaded.");
+  return to_packed_int32_array(loaded->triangles);
+}
+
+// Changing the tile size unloads every tile.
+void DelaunatorTileSet::set_tile_size(double tile_size) {
+
+  ERR_FAIL_COND_MSG(!(tile_size > 0), "tile_size must be positive.");
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (tile_set) delete(tile_set);
+  tile_set = new delaunator_cpp::TileSet(tile_size);
+}
+
+double DelaunatorTileSet::get_tile_size() {
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return tile_set->get_tile_size();
+}
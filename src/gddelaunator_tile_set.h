@@ -0,0 +1,51 @@
+#ifndef GDDELAUNATOR_TILE_SET_CLASS_H
+#define GDDELAUNATOR_TILE_SET_CLASS_H
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <mutex>
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+#include "tile_set.hpp"
+
+using namespace godot;
+
+
+// Triangulates a streamed world tile by tile; see delaunator_cpp::TileSet.
+class DelaunatorTileSet : public RefCounted {
+	GDCLASS(DelaunatorTileSet, RefCounted);
+
+protected:
+	static void _bind_methods();
+
+private:
+	// Every method holds the mutex, so one thread can load tiles while
+	// another reads them.
+	std::mutex mutex;
+	delaunator_cpp::TileSet *tile_set;
+
+public:
+
+	DelaunatorTileSet();
+	~DelaunatorTileSet();
+
+	// Functions
+	void load_tile(Vector2i tile, PackedVector2Array points);
+	void load_tiles(Array tiles, Array points);
+	void unload_tile(Vector2i tile);
+	bool has_tile(Vector2i tile);
+	Array get_loaded_tiles();
+	Rect2 get_tile_rect(Vector2i tile);
+	PackedVector2Array get_tile_vertices(Vector2i tile);
+	PackedInt32Array get_tile_triangles(Vector2i tile);
+
+	// Properties
+	void set_tile_size(double tile_size);
+	double get_tile_size();
+};
+
+#endif // ! GDDELAUNATOR_TILE_SET_CLASS_H
@@ -0,0 +1,119 @@
+#include "graph.hpp"
+
+#include <limits>
+#include <numeric>
+
+#include "parallel.hpp"
+
+namespace delaunator_cpp {
+
+namespace {
+
+// Disjoint sets of point indices, for Kruskal's algorithm
+class UnionFind {
+public:
+    explicit UnionFind(std::size_t n) : m_parent(n), m_size(n, 1)
+    {
+        std::iota(m_parent.begin(), m_parent.end(), 0);
+    }
+
+    std::size_t find(std::size_t i)
+    {
+        while (m_parent[i] != i) {
+            m_parent[i] = m_parent[m_parent[i]]; // path halving
+            i = m_parent[i];
+        }
+        return i;
+    }
+
+    // Returns false if a and b were already in the same set
+    bool unite(std::size_t a, std::size_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (m_size[a] < m_size[b]) std::swap(a, b);
+        m_parent[b] = a;
+        m_size[a] += m_size[b];
+        return true;
+    }
+
+private:
+    std::vector<std::size_t> m_parent;
+    std::vector<std::size_t> m_size;
+};
+
+struct WeightedEdge {
+    double length2;
+    std::size_t e;
+};
+
+} // namespace
+
+std::vector<std::size_t> minimum_spanning_tree(const Delaunator& delaunator)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const std::vector<std::size_t>& halfedges = delaunator.halfedges;
+    const godot::PackedVector2Array& points = delaunator.m_points;
+
+    // each edge once, by taking the lower index of each pair of halfedges
+    std::vector<WeightedEdge> edges;
+    edges.reserve(triangles.size() / 2 + 1);
+    for (std::size_t e = 0; e < triangles.size(); e++) {
+        if (halfedges[e] != INVALID_INDEX && halfedges[e] < e) continue;
+        const godot::Vector2& a = points[triangles[e]];
+        const godot::Vector2& b = points[triangles[next_halfedge(e)]];
+        edges.push_back({ Point::dist2(Point(a.x, a.y), Point(b.x, b.y)), e });
+    }
+
+    parallel_sort(edges.begin(), edges.end(),
+        [](const WeightedEdge& a, const WeightedEdge& b) { return a.length2 < b.length2; });
+
+    std::vector<std::size_t> result;
+    UnionFind sets(points.size());
+    for (const WeightedEdge& edge : edges) {
+        const std::size_t a = triangles[edge.e];
+        const std::size_t b = triangles[next_halfedge(edge.e)];
+        if (sets.unite(a, b)) {
+            result.push_back(a);
+            result.push_back(b);
+        }
+    }
+    return result;
+}
+
+std::vector<std::size_t> nearest_neighbors(const Delaunator& delaunator)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const godot::PackedVector2Array& points = delaunator.m_points;
+    const std::size_t n = points.size();
+
+    std::vector<std::size_t> nearest(n, INVALID_INDEX);
+    std::vector<double> nearest_dist2(n, (std::numeric_limits<double>::max)());
+
+    // hull edges only have one halfedge, so update both ends of every halfedge
+    for (std::size_t e = 0; e < triangles.size(); e++) {
+        const std::size_t a = triangles[e];
+        const std::size_t b = triangles[next_halfedge(e)];
+        const double d = Point::dist2(Point(points[a].x, points[a].y), Point(points[b].x, points[b].y));
+        if (d < nearest_dist2[a]) {
+            nearest_dist2[a] = d;
+            nearest[a] = b;
+        }
+        if (d < nearest_dist2[b]) {
+            nearest_dist2[b] = d;
+            nearest[b] = a;
+        }
+    }
+
+    std::vector<std::size_t> result;
+    result.reserve(2 * n);
+    for (std::size_t i = 0; i < n; i++) {
+        if (nearest[i] == INVALID_INDEX) continue;
+        result.push_back(i);
+        result.push_back(nearest[i]);
+    }
+    return result;
+}
+
+} //namespace delaunator_cpp
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// The Euclidean minimum spanning tree of the points, which is a subgraph of
+// the Delaunay triangulation. Returns the edges as a flat list of pairs of
+// point indices.
+std::vector<std::size_t> minimum_spanning_tree(const Delaunator& delaunator);
+
+// The nearest neighbor of each point, which is always one of its Delaunay
+// neighbors. Returns a flat list of (point, nearest neighbor) pairs, one pair
+// for each point in the triangulation.
+std::vector<std::size_t> nearest_neighbors(const Delaunator& delaunator);
+
+} //namespace delaunator_cpp
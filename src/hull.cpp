@@ -0,0 +1,142 @@
+#include "hull.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "validate.hpp"
+
+namespace delaunator_cpp {
+
+namespace {
+
+// As the sweep's test for near-duplicate points
+inline bool same_point(const godot::Vector2& a, const godot::Vector2& b)
+{
+    return std::fabs(a.x - b.x) <= CMP_EPSILON && std::fabs(a.y - b.y) <= CMP_EPSILON;
+}
+
+} // namespace
+
+void compute_hull(const godot::PackedVector2Array& points, Delaunator& result)
+{
+    const std::size_t n = points.size();
+    result = Delaunator();
+    result.m_points = points;
+    result.hull_prev.assign(n, INVALID_INDEX);
+    result.hull_next.assign(n, INVALID_INDEX);
+    result.hull_tri.assign(n, INVALID_INDEX);
+    if (n == 0) return;
+
+    const godot::Vector2 *p = points.ptr();
+
+    // The extreme points in eight directions, counterclockwise (with y up)
+    // from straight down, which make a convex octagon inside the hull.
+    std::size_t extremes[8] = {};
+    double best[8];
+    std::fill(best, best + 8, std::numeric_limits<double>::lowest());
+    for (std::size_t i = 0; i < n; i++) {
+        const double x = p[i].x;
+        const double y = p[i].y;
+        const double values[8] = { -y, x - y, x, x + y, y, y - x, -x, -x - y };
+        for (std::size_t k = 0; k < 8; k++) {
+            if (values[k] > best[k]) {
+                best[k] = values[k];
+                extremes[k] = i;
+            }
+        }
+    }
+    std::vector<godot::Vector2> octagon;
+    for (std::size_t k = 0; k < 8; k++) {
+        const godot::Vector2& corner = p[extremes[k]];
+        if (octagon.empty() || (corner != octagon.back() && corner != octagon.front())) {
+            octagon.push_back(corner);
+        }
+    }
+
+    // Points strictly inside the octagon can't be on the hull. Each side is
+    // turned into a line equation, with a margin covering the rounding of
+    // it and of the test for any point inside the bounding box, so the test
+    // is two multiplies and a compare per side. Every side is tested without
+    // branching, which is no slower as most points are inside.
+    struct Side {
+        double ex, ey, offset;
+    };
+    std::vector<Side> sides;
+    if (octagon.size() >= 3) {
+        const double max_x = std::max(std::abs(best[2]), std::abs(best[6]));
+        const double max_y = std::max(std::abs(best[4]), std::abs(best[0]));
+        for (std::size_t k = 0; k < octagon.size(); k++) {
+            const godot::Vector2& a = octagon[k];
+            const godot::Vector2& b = octagon[k + 1 == octagon.size() ? 0 : k + 1];
+            Side side;
+            side.ex = static_cast<double>(b.x) - a.x;
+            side.ey = static_cast<double>(b.y) - a.y;
+            const double c = side.ex * a.y - side.ey * a.x;
+            const double margin = 8.0 * std::numeric_limits<double>::epsilon() *
+                                  (std::abs(side.ex) * max_y + std::abs(side.ey) * max_x + std::abs(c));
+            side.offset = c + margin;
+            sides.push_back(side);
+        }
+    }
+
+    std::vector<std::size_t> candidates;
+    for (std::size_t i = 0; i < n; i++) {
+        const double x = p[i].x;
+        const double y = p[i].y;
+        bool inside = !sides.empty();
+        for (const Side& side : sides) {
+            inside &= side.ex * y - side.ey * x > side.offset;
+        }
+        if (!inside) candidates.push_back(i);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [p](std::size_t i, std::size_t j) {
+        if (p[i].x != p[j].x) return p[i].x < p[j].x;
+        if (p[i].y != p[j].y) return p[i].y < p[j].y;
+        return i < j;
+    });
+
+    std::vector<std::size_t> hull;
+    const std::size_t first = candidates.front();
+    const std::size_t last = candidates.back();
+    const bool collinear = std::all_of(candidates.begin(), candidates.end(), [&](std::size_t i) {
+        return exact_orientation(p[first], p[last], p[i]) == 0;
+    });
+    if (collinear) {
+        hull.push_back(first);
+        if (!same_point(p[first], p[last])) hull.push_back(last);
+    } else {
+        // Andrew's monotone chain: the lower chain left to right, then the
+        // upper chain back, each turning only left. Collinear points are
+        // kept, as the sweep keeps points on hull edges.
+        auto add = [&](std::size_t i, std::size_t chain_start) {
+            if (!hull.empty() && same_point(p[hull.back()], p[i])) return;
+            while (hull.size() >= chain_start + 2 &&
+                   exact_orientation(p[hull[hull.size() - 2]], p[hull.back()], p[i]) < 0) {
+                hull.pop_back();
+            }
+            hull.push_back(i);
+        };
+        for (std::size_t i : candidates) {
+            add(i, 0);
+        }
+        const std::size_t lower_size = hull.size() - 1;
+        for (std::size_t k = candidates.size() - 1; k-- > 0;) {
+            add(candidates[k], lower_size);
+        }
+        hull.pop_back(); // back at the start
+        // the sweep's hull runs clockwise with y up, as its triangles do
+        std::reverse(hull.begin(), hull.end());
+    }
+
+    for (std::size_t k = 0; k < hull.size(); k++) {
+        const std::size_t next = hull[k + 1 == hull.size() ? 0 : k + 1];
+        result.hull_next[hull[k]] = next;
+        result.hull_prev[next] = hull[k];
+    }
+    result.hull_start = hull.front();
+}
+
+} //namespace delaunator_cpp
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// The convex hull of the points, without triangulating them. 'result'
+// receives the points and a hull (hull_start, hull_next and hull_prev)
+// running the same way round as the sweep's, with hull_tri INVALID_INDEX
+// and no triangles, so get_hull_area() gives the triangulation's area.
+// As in the triangulation, points on a hull edge are on the hull, and of
+// duplicate points only one is; the hull can start at a different point.
+// Collinear points give a hull of the two end points, and a single point
+// (or copies of it) a hull of that point.
+//
+// Points inside the octagon of the extreme points in eight directions are
+// dropped first (Akl-Toussaint), which for most inputs leaves few for
+// Andrew's monotone chain to sort.
+void compute_hull(const godot::PackedVector2Array& points, Delaunator& result);
+
+} //namespace delaunator_cpp
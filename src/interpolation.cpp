@@ -0,0 +1,272 @@
+#include "interpolation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "delaunator_predicates.hpp"
+
+namespace delaunator_cpp {
+
+namespace {
+
+constexpr float NOT_A_NUMBER = std::numeric_limits<float>::quiet_NaN();
+
+// The pixels from 'first' to 'end' have their centers between low and high,
+// in pixels. The bounds are clamped before converting, as a triangle can be
+// far outside the image; first > end when no pixel is covered.
+inline void pixel_span(double low, double high, long long last, long long& first, long long& end)
+{
+    first = static_cast<long long>(std::min(std::max(std::ceil(low - 0.5), 0.0), last + 1.0));
+    end = static_cast<long long>(std::max(std::min(std::floor(high - 0.5), static_cast<double>(last)), -1.0));
+}
+
+// Barycentric interpolation of 'values' at p, within triangle t
+float interpolate_in_triangle(
+    const Delaunator& delaunator,
+    const float *values,
+    std::size_t t,
+    const godot::Vector2& p)
+{
+    const std::size_t i0 = delaunator.triangles[3 * t];
+    const std::size_t i1 = delaunator.triangles[3 * t + 1];
+    const std::size_t i2 = delaunator.triangles[3 * t + 2];
+    const godot::Vector2& a = delaunator.m_points[i0];
+    const godot::Vector2& b = delaunator.m_points[i1];
+    const godot::Vector2& c = delaunator.m_points[i2];
+
+    const double bx = static_cast<double>(b.x) - a.x;
+    const double by = static_cast<double>(b.y) - a.y;
+    const double cx = static_cast<double>(c.x) - a.x;
+    const double cy = static_cast<double>(c.y) - a.y;
+    const double px = static_cast<double>(p.x) - a.x;
+    const double py = static_cast<double>(p.y) - a.y;
+
+    const double det = bx * cy - cx * by;
+    if (det == 0.0) return values[i0];
+
+    const double u = (px * cy - cx * py) / det;
+    const double v = (bx * py - px * by) / det;
+    return static_cast<float>((1.0 - u - v) * values[i0] + u * values[i1] + v * values[i2]);
+}
+
+} // namespace
+
+void interpolate_linear(
+    const Delaunator& delaunator,
+    const float *values,
+    const godot::Vector2 *queries,
+    std::size_t count,
+    float *results)
+{
+    std::size_t t = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        const std::size_t found = delaunator.locate(queries[i], t);
+        if (found == INVALID_INDEX) {
+            results[i] = NOT_A_NUMBER;
+            continue;
+        }
+        t = found;
+        results[i] = interpolate_in_triangle(delaunator, values, t, queries[i]);
+    }
+}
+
+void interpolate_natural_neighbor(
+    const Delaunator& delaunator,
+    const float *values,
+    const godot::Vector2 *queries,
+    std::size_t count,
+    float *results)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const std::vector<std::size_t>& halfedges = delaunator.halfedges;
+    const godot::PackedVector2Array& points = delaunator.m_points;
+
+    // Triangles are marked as visited by stamping them with the current
+    // generation, so the array doesn't need clearing between queries.
+    std::vector<std::uint32_t> visited(triangles.size() / 3, 0);
+    std::uint32_t generation = 0;
+    std::vector<std::size_t> stack;
+    std::vector<std::pair<std::size_t, double>> weights;
+
+    std::size_t t = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        const godot::Vector2& q = queries[i];
+        const std::size_t found = delaunator.locate(q, t);
+        if (found == INVALID_INDEX) {
+            results[i] = NOT_A_NUMBER;
+            continue;
+        }
+        t = found;
+
+        // the stolen areas are degenerate when q is on a data point
+        const std::size_t* corner = std::find_if(&triangles[3 * t], &triangles[3 * t] + 3,
+            [&](std::size_t v) { return points[v] == q; });
+        if (corner != &triangles[3 * t] + 3) {
+            results[i] = values[*corner];
+            continue;
+        }
+
+        if (++generation == 0) {
+            std::fill(visited.begin(), visited.end(), 0);
+            generation = 1;
+        }
+
+        // Watson's method: the Voronoi cell that q would have is made of
+        // area "stolen" from its natural neighbors, and each triangle whose
+        // circumcircle contains q (the cavity q would make if inserted)
+        // contributes a triangle of stolen area to each of its corners.
+        weights.clear();
+        stack.clear();
+        stack.push_back(t);
+        visited[t] = generation;
+
+        while (!stack.empty()) {
+            const std::size_t c = stack.back();
+            stack.pop_back();
+
+            const std::size_t e0 = 3 * c;
+            const Point center = circumcenter(
+                points[triangles[e0]],
+                points[triangles[e0 + 1]],
+                points[triangles[e0 + 2]]);
+
+            for (std::size_t e = e0; e < e0 + 3; e++) {
+                const std::size_t v = triangles[e];
+                const Point g_next = circumcenter(q, points[v], points[triangles[next_halfedge(e)]]);
+                const Point g_prev = circumcenter(q, points[triangles[prev_halfedge(e)]], points[v]);
+                const double area = Point::determinant(
+                    Point::vector(center, g_next),
+                    Point::vector(center, g_prev));
+
+                auto weight = std::find_if(weights.begin(), weights.end(),
+                    [v](const std::pair<std::size_t, double>& w) { return w.first == v; });
+                if (weight == weights.end()) {
+                    weights.emplace_back(v, area);
+                } else {
+                    weight->second += area;
+                }
+
+                // grow the cavity into neighbors whose circumcircle holds q
+                const std::size_t opposite = halfedges[e];
+                if (opposite == INVALID_INDEX) continue;
+                const std::size_t n = opposite / 3;
+                if (visited[n] == generation) continue;
+                visited[n] = generation;
+
+                const std::size_t n0 = 3 * n;
+                const godot::Vector2& a = points[triangles[n0]];
+                const Point n_center = circumcenter(a, points[triangles[n0 + 1]], points[triangles[n0 + 2]]);
+                const Point qp(q.x, q.y);
+                if (Point::dist2(qp, n_center) < Point::dist2(Point(a.x, a.y), n_center)) {
+                    stack.push_back(n);
+                }
+            }
+        }
+
+        double total = 0.0;
+        double value = 0.0;
+        for (const std::pair<std::size_t, double>& w : weights) {
+            total += w.second;
+            value += w.second * values[w.first];
+        }
+        value /= total;
+
+        // q on an edge also makes the stolen areas degenerate, but there
+        // the interpolation matches the linear one anyway
+        if (!std::isfinite(value)) {
+            results[i] = interpolate_in_triangle(delaunator, values, t, q);
+        } else {
+            results[i] = static_cast<float>(value);
+        }
+    }
+}
+
+void rasterize(
+    const Delaunator& delaunator,
+    const float *values,
+    const godot::Rect2& rect,
+    std::size_t width,
+    std::size_t height,
+    float *pixels)
+{
+    std::fill(pixels, pixels + width * height, NOT_A_NUMBER);
+    if (width == 0 || height == 0 || !(rect.size.x > 0) || !(rect.size.y > 0)) return;
+
+    const double x0 = rect.position.x;
+    const double y0 = rect.position.y;
+    const double pixel_width = static_cast<double>(rect.size.x) / width;
+    const double pixel_height = static_cast<double>(rect.size.y) / height;
+    const long long last_column = static_cast<long long>(width) - 1;
+    const long long last_row = static_cast<long long>(height) - 1;
+
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const godot::PackedVector2Array& points = delaunator.m_points;
+
+    for (std::size_t e0 = 0; e0 < triangles.size(); e0 += 3) {
+        const std::size_t i0 = triangles[e0];
+        const std::size_t i1 = triangles[e0 + 1];
+        const std::size_t i2 = triangles[e0 + 2];
+        const godot::Vector2 corners[3] = { points[i0], points[i1], points[i2] };
+
+        // values are linear over the triangle, so find the plane
+        // value = dx * x + dy * y + offset
+        const double bx = static_cast<double>(corners[1].x) - corners[0].x;
+        const double by = static_cast<double>(corners[1].y) - corners[0].y;
+        const double cx = static_cast<double>(corners[2].x) - corners[0].x;
+        const double cy = static_cast<double>(corners[2].y) - corners[0].y;
+        const double det = bx * cy - cx * by;
+        if (det == 0.0) continue;
+
+        const double fb = static_cast<double>(values[i1]) - values[i0];
+        const double fc = static_cast<double>(values[i2]) - values[i0];
+        const double dx = (fb * cy - fc * by) / det;
+        const double dy = (fc * bx - fb * cx) / det;
+        const double offset = values[i0] - dx * corners[0].x - dy * corners[0].y;
+
+        const double min_y = std::min({ corners[0].y, corners[1].y, corners[2].y });
+        const double max_y = std::max({ corners[0].y, corners[1].y, corners[2].y });
+        long long first_row, end_row;
+        pixel_span((min_y - y0) / pixel_height, (max_y - y0) / pixel_height, last_row, first_row, end_row);
+
+        for (long long row = first_row; row <= end_row; row++) {
+            const double y = y0 + (row + 0.5) * pixel_height;
+
+            // the span of the row covered by the triangle
+            double min_x = (std::numeric_limits<double>::max)();
+            double max_x = std::numeric_limits<double>::lowest();
+            for (int k = 0; k < 3; k++) {
+                godot::Vector2 p = corners[k];
+                godot::Vector2 q = corners[(k + 1) % 3];
+                // order the ends so the triangles sharing this edge agree
+                // exactly on where it crosses the row
+                if (q.y < p.y || (q.y == p.y && q.x < p.x)) std::swap(p, q);
+                if (y < p.y || y > q.y) continue;
+
+                if (p.y == q.y) {
+                    min_x = std::min(min_x, static_cast<double>(p.x));
+                    max_x = std::max(max_x, static_cast<double>(q.x));
+                } else {
+                    const double x = p.x + (y - p.y) * (static_cast<double>(q.x) - p.x) / (static_cast<double>(q.y) - p.y);
+                    min_x = std::min(min_x, x);
+                    max_x = std::max(max_x, x);
+                }
+            }
+            if (min_x > max_x) continue;
+
+            long long first_column, end_column;
+            pixel_span((min_x - x0) / pixel_width, (max_x - x0) / pixel_width, last_column, first_column, end_column);
+
+            float *pixel = pixels + row * width;
+            for (long long column = first_column; column <= end_column; column++) {
+                const double x = x0 + (column + 0.5) * pixel_width;
+                pixel[column] = static_cast<float>(dx * x + dy * y + offset);
+            }
+        }
+    }
+}
+
+} //namespace delaunator_cpp
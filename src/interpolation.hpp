@@ -0,0 +1,43 @@
+#pragma once
+
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// Interpolates the per-point 'values' at 'count' query points, writing the
+// results to 'results'. Queries outside the hull are given NaN.
+//
+// Each query is located by walking from the triangle of the previous query,
+// so queries which are sorted spatially (rows of a grid, etc) are cheapest.
+void interpolate_linear(
+    const Delaunator& delaunator,
+    const float *values,
+    const godot::Vector2 *queries,
+    std::size_t count,
+    float *results);
+
+// As interpolate_linear() but using Sibson's natural neighbor coordinates,
+// which are smooth across triangle edges.
+void interpolate_natural_neighbor(
+    const Delaunator& delaunator,
+    const float *values,
+    const godot::Vector2 *queries,
+    std::size_t count,
+    float *results);
+
+// Linearly interpolates 'values' into a row-major width * height buffer of
+// pixels covering 'rect', sampled at the pixel centers. Each triangle is
+// scan-converted directly, pixels outside the hull are set to NaN. A rect
+// without a positive size leaves every pixel NaN.
+void rasterize(
+    const Delaunator& delaunator,
+    const float *values,
+    const godot::Rect2& rect,
+    std::size_t width,
+    std::size_t height,
+    float *pixels);
+
+} //namespace delaunator_cpp
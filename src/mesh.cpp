@@ -0,0 +1,113 @@
+#include "mesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace delaunator_cpp {
+
+void build_mesh(
+    const Delaunator& delaunator,
+    const float *heights,
+    godot::Vector3 *vertices,
+    godot::Vector3 *normals,
+    godot::Vector2 *uvs,
+    float *tangents,
+    std::int32_t *indices)
+{
+    constexpr std::size_t MIN_CHUNK = 4096;
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const godot::PackedVector2Array& points = delaunator.m_points;
+    const std::size_t point_count = points.size();
+    const std::size_t triangle_count = triangles.size() / 3;
+
+    // Once y becomes z the triangles wind counterclockwise seen from above,
+    // and Godot's front faces are clockwise, so they're emitted as a, c, b.
+    parallel_for(triangle_count, MIN_CHUNK, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; t++) {
+            indices[3 * t] = static_cast<std::int32_t>(triangles[3 * t]);
+            indices[3 * t + 1] = static_cast<std::int32_t>(triangles[3 * t + 2]);
+            indices[3 * t + 2] = static_cast<std::int32_t>(triangles[3 * t + 1]);
+        }
+    });
+
+    godot::Vector2 uv_origin;
+    godot::Vector2 uv_scale;
+    if (uvs && point_count > 0) {
+        godot::Vector2 min = points[0];
+        godot::Vector2 max = points[0];
+        for (std::size_t i = 1; i < point_count; i++) {
+            min = godot::Vector2(std::min(min.x, points[i].x), std::min(min.y, points[i].y));
+            max = godot::Vector2(std::max(max.x, points[i].x), std::max(max.y, points[i].y));
+        }
+        uv_origin = min;
+        uv_scale = godot::Vector2(
+            max.x > min.x ? 1.0f / (max.x - min.x) : 0.0f,
+            max.y > min.y ? 1.0f / (max.y - min.y) : 0.0f);
+    }
+
+    // Each thread owns a range of the points and streams through all the
+    // triangles, adding the normals of those using its points, so nothing
+    // is written by two threads. (b - a) x (c - a) points up, and being
+    // unnormalized it weights each triangle's normal by its area.
+    parallel_for(point_count, MIN_CHUNK, [&](std::size_t begin, std::size_t end) {
+        std::vector<double> sums(3 * (end - begin), 0.0);
+        for (std::size_t e = 0; e < triangles.size(); e += 3) {
+            const std::size_t a = triangles[e];
+            const std::size_t b = triangles[e + 1];
+            const std::size_t c = triangles[e + 2];
+            if (a - begin >= end - begin && b - begin >= end - begin && c - begin >= end - begin) continue;
+
+            const double abx = static_cast<double>(points[b].x) - points[a].x;
+            const double aby = static_cast<double>(heights[b]) - heights[a];
+            const double abz = static_cast<double>(points[b].y) - points[a].y;
+            const double acx = static_cast<double>(points[c].x) - points[a].x;
+            const double acy = static_cast<double>(heights[c]) - heights[a];
+            const double acz = static_cast<double>(points[c].y) - points[a].y;
+            const double nx = aby * acz - abz * acy;
+            const double ny = abz * acx - abx * acz;
+            const double nz = abx * acy - aby * acx;
+            for (std::size_t i : {a, b, c}) {
+                if (i - begin >= end - begin) continue;
+                double *sum = &sums[3 * (i - begin)];
+                sum[0] += nx;
+                sum[1] += ny;
+                sum[2] += nz;
+            }
+        }
+
+        for (std::size_t i = begin; i < end; i++) {
+            const godot::Vector2& p = points[i];
+            vertices[i] = godot::Vector3(p.x, heights[i], p.y);
+
+            const double nx = sums[3 * (i - begin)];
+            const double ny = sums[3 * (i - begin) + 1];
+            const double nz = sums[3 * (i - begin) + 2];
+            const double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+            const godot::Vector3 normal = length > 0.0
+                ? godot::Vector3(static_cast<float>(nx / length), static_cast<float>(ny / length), static_cast<float>(nz / length))
+                : godot::Vector3(0, 1, 0);
+            normals[i] = normal;
+
+            if (uvs) {
+                uvs[i] = godot::Vector2((p.x - uv_origin.x) * uv_scale.x, (p.y - uv_origin.y) * uv_scale.y);
+            }
+            if (tangents) {
+                // The surface's slope along x, which is the direction of
+                // increasing U. The normals all point up, so increasing V
+                // (along z) is always the opposite of normal x tangent.
+                const double tx = normal.y;
+                const double ty = -normal.x;
+                const double t_length = std::sqrt(tx * tx + ty * ty);
+                tangents[4 * i] = t_length > 0.0 ? static_cast<float>(tx / t_length) : 1.0f;
+                tangents[4 * i + 1] = t_length > 0.0 ? static_cast<float>(ty / t_length) : 0.0f;
+                tangents[4 * i + 2] = 0.0f;
+                tangents[4 * i + 3] = -1.0f;
+            }
+        }
+    });
+}
+
+} //namespace delaunator_cpp
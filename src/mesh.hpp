@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// Lifts the triangulation into a 3D surface, with each point (x, y) becoming
+// the vertex (x, heights[i], y). Writes one vertex, normal and (if the
+// pointers aren't null) UV and tangent per point, and three indices per
+// triangle, in the layout and winding ArrayMesh expects:
+//
+// - normals are the area weighted average of the normals of the triangles
+//   using each point, or straight up for points in no triangle
+// - UVs map the bounding box of the points to [0, 1]
+// - tangents are four floats per point: the direction of increasing U in
+//   the surface, then the sign which gives the direction of increasing V
+//
+// The points are split into ranges on separate threads, each of which makes
+// one pass over the triangles, so no two threads write to the same vertex.
+void build_mesh(
+    const Delaunator& delaunator,
+    const float *heights,
+    godot::Vector3 *vertices,
+    godot::Vector3 *normals,
+    godot::Vector2 *uvs,
+    float *tangents,
+    std::int32_t *indices);
+
+} //namespace delaunator_cpp
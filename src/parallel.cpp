@@ -0,0 +1,163 @@
+#include "parallel.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace delaunator_cpp {
+
+namespace {
+
+std::atomic<std::size_t> configured_workers{ 0 };
+
+// Threads which wait for tasks, so that parallel calls don't pay for
+// starting threads each time. Tasks are handed out one index at a time from
+// the oldest job with any left.
+class WorkerPool {
+public:
+    ~WorkerPool()
+    {
+        stop();
+    }
+
+    void run(std::size_t count, const std::function<void(std::size_t)>& task)
+    {
+        Job job;
+        job.task = &task;
+        job.count = count;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const std::size_t thread_count = worker_count() - 1;
+        while (!m_stopping && m_threads.size() < thread_count) {
+            m_threads.emplace_back([this] { work(); });
+        }
+        m_jobs.push_back(&job);
+        m_work_ready.notify_all();
+
+        while (job.next < job.count) {
+            run_task(lock, job, claim(job));
+        }
+        m_work_done.wait(lock, [&] { return job.done == job.count; });
+        if (job.error) std::rethrow_exception(job.error);
+    }
+
+    void stop()
+    {
+        std::vector<std::thread> threads;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+            threads.swap(m_threads);
+        }
+        m_work_ready.notify_all();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = false;
+    }
+
+private:
+    struct Job {
+        const std::function<void(std::size_t)> *task = nullptr;
+        std::size_t count = 0;
+        std::size_t next = 0;
+        std::size_t done = 0;
+        // the first exception a task threw
+        std::exception_ptr error;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_work_ready;
+    std::condition_variable m_work_done;
+    std::deque<Job*> m_jobs;
+    std::vector<std::thread> m_threads;
+    bool m_stopping = false;
+
+    // Takes the job's next task, dropping the job from the queue once
+    // they've all been taken. Needs m_mutex held.
+    std::size_t claim(Job& job)
+    {
+        const std::size_t i = job.next++;
+        if (job.next == job.count) {
+            for (auto it = m_jobs.begin(); it != m_jobs.end(); ++it) {
+                if (*it == &job) {
+                    m_jobs.erase(it);
+                    break;
+                }
+            }
+        }
+        return i;
+    }
+
+    // Runs the job's task i with m_mutex unlocked, keeping the first
+    // exception a task throws for run() to rethrow on the calling thread,
+    // as one escaping a worker would end the program. Once a task has
+    // thrown the rest are skipped. Needs m_mutex held.
+    void run_task(std::unique_lock<std::mutex>& lock, Job& job, std::size_t i)
+    {
+        const bool failed = static_cast<bool>(job.error);
+        lock.unlock();
+        std::exception_ptr error;
+        if (!failed) {
+            try {
+                (*job.task)(i);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        lock.lock();
+        if (error && !job.error) job.error = error;
+        job.done++;
+    }
+
+    void work()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_work_ready.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) return;
+
+            Job& job = *m_jobs.front();
+            run_task(lock, job, claim(job));
+            if (job.done == job.count) {
+                m_work_done.notify_all();
+            }
+        }
+    }
+};
+
+WorkerPool& pool()
+{
+    static WorkerPool workers;
+    return workers;
+}
+
+} // namespace
+
+std::size_t worker_count()
+{
+    const std::size_t count = configured_workers.load(std::memory_order_relaxed);
+    return count > 0 ? count : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+void set_worker_count(std::size_t count)
+{
+    configured_workers.store(count, std::memory_order_relaxed);
+    pool().stop();
+}
+
+void stop_workers()
+{
+    pool().stop();
+}
+
+void run_tasks(std::size_t count, const std::function<void(std::size_t)>& task)
+{
+    pool().run(count, task);
+}
+
+} //namespace delaunator_cpp
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace delaunator_cpp {
+
+// The number of threads the parallel paths split their work across,
+// counting the thread which calls them. Defaults to the hardware's thread
+// count.
+std::size_t worker_count();
+
+// Sets worker_count(), with 0 restoring the default. The pool's threads are
+// stopped and restarted at the new size on next use, so this mustn't be
+// called from inside parallel work.
+void set_worker_count(std::size_t count);
+
+// Stops the pool's threads, which must happen before the library is
+// unloaded. They're started again by the next parallel call.
+void stop_workers();
+
+// Calls task(i) for each i in [0, count) on the pool's threads and the
+// calling thread, returning once they've all finished. The caller works
+// through its own tasks rather than waiting for a free thread, so tasks can
+// make parallel calls of their own. If a task throws, the tasks not yet
+// started are skipped and the first exception is rethrown here.
+void run_tasks(std::size_t count, const std::function<void(std::size_t)>& task);
+
+// Calls fn(begin, end) for contiguous chunks covering [0, count), with the
+// chunks running on separate threads. Work smaller than 'min_chunk' items per
+// thread isn't worth a thread, so small counts just run on the caller.
+template <class F>
+void parallel_for(std::size_t count, std::size_t min_chunk, F fn)
+{
+    const std::size_t chunks = std::min(worker_count(), std::max<std::size_t>(1, count / std::max<std::size_t>(1, min_chunk)));
+    if (chunks <= 1) {
+        fn(std::size_t(0), count);
+        return;
+    }
+
+    run_tasks(chunks, [&](std::size_t c) {
+        fn(count * c / chunks, count * (c + 1) / chunks);
+    });
+}
+
+// std::sort, with the range sorted in chunks on separate threads and then
+// merged pairwise.
+template <class RandomIt, class Compare>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp)
+{
+    constexpr std::size_t MIN_CHUNK = 16384;
+    const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+    const std::size_t chunks = std::min(worker_count(), std::max<std::size_t>(1, count / MIN_CHUNK));
+    if (chunks <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t c = 0; c <= chunks; c++) {
+        bounds[c] = count * c / chunks;
+    }
+    parallel_for(chunks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; c++) {
+            std::sort(first + bounds[c], first + bounds[c + 1], comp);
+        }
+    });
+
+    // merge neighbouring runs until there's one left
+    for (std::size_t width = 1; width < chunks; width *= 2) {
+        const std::size_t merges = (chunks + 2 * width - 1) / (2 * width);
+        parallel_for(merges, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t m = begin; m < end; m++) {
+                const std::size_t lo = 2 * width * m;
+                const std::size_t mid = std::min(lo + width, chunks);
+                const std::size_t hi = std::min(lo + 2 * width, chunks);
+                if (mid < hi) {
+                    std::inplace_merge(first + bounds[lo], first + bounds[mid], first + bounds[hi], comp);
+                }
+            }
+        });
+    }
+}
+
+} //namespace delaunator_cpp
@@ -0,0 +1,233 @@
+#include "path_finding.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "parallel.hpp"
+
+namespace delaunator_cpp {
+
+namespace {
+
+// Search state sized to the point count, reused between searches. Entries
+// are only valid where 'stamp' matches the current search's generation, so
+// nothing needs clearing between searches.
+struct PathSearch {
+    struct Open {
+        double f;
+        std::size_t point;
+        bool operator<(const Open& other) const { return f > other.f; } // min-heap
+    };
+
+    std::vector<double> g;
+    std::vector<std::size_t> came_from;
+    std::vector<std::uint32_t> stamp;
+    // the points find_nearest_paths() hasn't reached yet, marked with the
+    // generation as 'stamp' is
+    std::vector<std::uint32_t> wanted;
+    std::vector<Open> open;
+    std::uint32_t generation = 0;
+
+    void begin(std::size_t point_count)
+    {
+        if (stamp.size() < point_count) {
+            g.resize(point_count);
+            came_from.resize(point_count);
+            stamp.resize(point_count, 0);
+            wanted.resize(point_count, 0);
+        }
+        if (++generation == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            std::fill(wanted.begin(), wanted.end(), 0);
+            generation = 1;
+        }
+        open.clear();
+    }
+
+    // Starts a path at 'source'.
+    void seed(std::size_t source, double h)
+    {
+        stamp[source] = generation;
+        g[source] = 0.0;
+        came_from[source] = INVALID_INDEX;
+        open.push_back({ h, source });
+        std::push_heap(open.begin(), open.end());
+    }
+
+    // The path found to 'to', from the source it was reached from.
+    std::vector<std::size_t> path_to(std::size_t to) const
+    {
+        std::vector<std::size_t> path;
+        if (stamp[to] != generation) return path;
+        for (std::size_t p = to; p != INVALID_INDEX; p = came_from[p]) {
+            path.push_back(p);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+};
+
+thread_local PathSearch t_search;
+
+inline double distance(const godot::Vector2& a, const godot::Vector2& b)
+{
+    const double dx = static_cast<double>(a.x) - b.x;
+    const double dy = static_cast<double>(a.y) - b.y;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+// Calls fn(neighbor) for each point sharing an edge with p, rotating from
+// its incoming edge through the outgoing ones.
+template <class F>
+void for_each_neighbor(const Delaunator& delaunator, const std::vector<std::size_t>& inedges, std::size_t p, F fn)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const std::vector<std::size_t>& halfedges = delaunator.halfedges;
+
+    const std::size_t e0 = inedges[p];
+    std::size_t e = e0;
+    do {
+        fn(triangles[e]);
+        const std::size_t outgoing = next_halfedge(e);
+        e = halfedges[outgoing];
+        if (e == INVALID_INDEX) {
+            fn(triangles[next_halfedge(outgoing)]);
+            break;
+        }
+    } while (e != e0);
+}
+
+} // namespace
+
+void build_inedges(const Delaunator& delaunator, std::vector<std::size_t>& inedges)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const std::vector<std::size_t>& halfedges = delaunator.halfedges;
+
+    inedges.assign(delaunator.m_points.size(), INVALID_INDEX);
+    for (std::size_t e = 0; e < triangles.size(); e++) {
+        const std::size_t p = triangles[next_halfedge(e)];
+        if (halfedges[e] == INVALID_INDEX || inedges[p] == INVALID_INDEX) {
+            inedges[p] = e;
+        }
+    }
+}
+
+std::vector<std::size_t> find_path(
+    const Delaunator& delaunator,
+    const std::vector<std::size_t>& inedges,
+    std::size_t from,
+    std::size_t to)
+{
+    const godot::PackedVector2Array& points = delaunator.m_points;
+
+    if (from >= inedges.size() || to >= inedges.size() ||
+        inedges[from] == INVALID_INDEX || inedges[to] == INVALID_INDEX) {
+        return {};
+    }
+
+    PathSearch& search = t_search;
+    search.begin(points.size());
+    const godot::Vector2& target = points[to];
+    search.seed(from, distance(points[from], target));
+
+    auto relax = [&](std::size_t p, std::size_t neighbor) {
+        const double g = search.g[p] + distance(points[p], points[neighbor]);
+        if (search.stamp[neighbor] == search.generation && search.g[neighbor] <= g) return;
+        search.stamp[neighbor] = search.generation;
+        search.g[neighbor] = g;
+        search.came_from[neighbor] = p;
+        search.open.push_back({ g + distance(points[neighbor], target), neighbor });
+        std::push_heap(search.open.begin(), search.open.end());
+    };
+
+    while (!search.open.empty()) {
+        std::pop_heap(search.open.begin(), search.open.end());
+        const PathSearch::Open current = search.open.back();
+        search.open.pop_back();
+
+        const std::size_t p = current.point;
+        if (p == to) break;
+        // skip stale heap entries for points which have since been improved
+        if (current.f > search.g[p] + distance(points[p], target)) continue;
+
+        for_each_neighbor(delaunator, inedges, p, [&](std::size_t neighbor) { relax(p, neighbor); });
+    }
+    return search.path_to(to);
+}
+
+std::vector<std::vector<std::size_t>> find_nearest_paths(
+    const Delaunator& delaunator,
+    const std::vector<std::size_t>& inedges,
+    const std::vector<std::size_t>& sources,
+    const std::vector<std::size_t>& targets)
+{
+    const godot::PackedVector2Array& points = delaunator.m_points;
+    auto valid = [&](std::size_t p) {
+        return p < inedges.size() && inedges[p] != INVALID_INDEX;
+    };
+
+    PathSearch& search = t_search;
+    search.begin(points.size());
+    for (const std::size_t source : sources) {
+        if (valid(source) && search.stamp[source] != search.generation) search.seed(source, 0.0);
+    }
+    std::size_t remaining = 0;
+    for (const std::size_t target : targets) {
+        if (valid(target) && search.wanted[target] != search.generation) {
+            search.wanted[target] = search.generation;
+            remaining++;
+        }
+    }
+
+    // Dijkstra, as there's no single target to aim for: a point's distance
+    // is final when it's popped, which is when a target has been reached
+    while (remaining > 0 && !search.open.empty()) {
+        std::pop_heap(search.open.begin(), search.open.end());
+        const PathSearch::Open current = search.open.back();
+        search.open.pop_back();
+
+        const std::size_t p = current.point;
+        if (current.f > search.g[p]) continue; // stale
+        if (search.wanted[p] == search.generation) {
+            search.wanted[p] = 0;
+            remaining--;
+        }
+
+        for_each_neighbor(delaunator, inedges, p, [&](std::size_t neighbor) {
+            const double g = search.g[p] + distance(points[p], points[neighbor]);
+            if (search.stamp[neighbor] == search.generation && search.g[neighbor] <= g) return;
+            search.stamp[neighbor] = search.generation;
+            search.g[neighbor] = g;
+            search.came_from[neighbor] = p;
+            search.open.push_back({ g, neighbor });
+            std::push_heap(search.open.begin(), search.open.end());
+        });
+    }
+
+    std::vector<std::vector<std::size_t>> paths(targets.size());
+    for (std::size_t i = 0; i < targets.size(); i++) {
+        if (valid(targets[i])) paths[i] = search.path_to(targets[i]);
+    }
+    return paths;
+}
+
+std::vector<std::vector<std::size_t>> find_paths(
+    const Delaunator& delaunator,
+    const std::vector<std::size_t>& inedges,
+    const std::vector<std::size_t>& from,
+    const std::vector<std::size_t>& to)
+{
+    const std::size_t count = std::min(from.size(), to.size());
+    std::vector<std::vector<std::size_t>> paths(count);
+
+    parallel_for(count, 16, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            paths[i] = find_path(delaunator, inedges, from[i], to[i]);
+        }
+    });
+    return paths;
+}
+
+} //namespace delaunator_cpp
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// Fills 'inedges' with a halfedge ending at each point, which is the
+// incoming hull edge for points on the hull so that rotating from it visits
+// every neighbor. Points missing from the triangulation get INVALID_INDEX.
+void build_inedges(const Delaunator& delaunator, std::vector<std::size_t>& inedges);
+
+// The shortest path along the triangulation's edges between two points,
+// found with A* over the halfedges using Euclidean edge lengths. Returns the
+// point indices along the path, including both ends, or an empty path if
+// either point isn't in the triangulation.
+//
+// The search state lives in per-thread buffers which are reused by later
+// searches, so searches can run concurrently on separate threads.
+std::vector<std::size_t> find_path(
+    const Delaunator& delaunator,
+    const std::vector<std::size_t>& inedges,
+    std::size_t from,
+    std::size_t to);
+
+// Calls find_path() for each from[i], to[i] pair, with the searches spread
+// across threads. Each pair is a separate search; find_nearest_paths()
+// shares one search between many sources.
+std::vector<std::vector<std::size_t>> find_paths(
+    const Delaunator& delaunator,
+    const std::vector<std::size_t>& inedges,
+    const std::vector<std::size_t>& from,
+    const std::vector<std::size_t>& to);
+
+// The shortest path to each of the targets from whichever of the sources
+// is nearest to it along the edges, from a single Dijkstra search with
+// every source on its frontier, which stops once all the targets are
+// reached. Paths run from the source to targets[i], at index i. A target
+// which can't be reached, or isn't in the triangulation, gets an empty path,
+// and one which is a source a path of just itself. Uses the same per-thread
+// buffers as find_path().
+std::vector<std::vector<std::size_t>> find_nearest_paths(
+    const Delaunator& delaunator,
+    const std::vector<std::size_t>& inedges,
+    const std::vector<std::size_t>& sources,
+    const std::vector<std::size_t>& targets);
+
+} //namespace delaunator_cpp
@@ -0,0 +1,274 @@
+#include "periodic.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+
+#include "delaunator_predicates.hpp"
+#include "validate.hpp"
+
+namespace delaunator_cpp {
+
+namespace {
+
+// Above this many points copied or considered for copying, the domain is
+// taken to be too narrow for its points to be triangulated. This also keeps
+// the edge keys below within 64 bits.
+constexpr double MAX_COPY_WORK = 1 << 26;
+
+// A copy of an input point, shifted by whole domain sizes
+struct Copy {
+    std::size_t source;
+    godot::Vector2i offset;
+
+    bool operator<(const Copy& other) const
+    {
+        return std::tie(source, offset.x, offset.y) <
+               std::tie(other.source, other.offset.x, other.offset.y);
+    }
+};
+
+inline double wrap(double value, double start, double size)
+{
+    double offset = std::fmod(value - start, size);
+    if (offset < 0.0) offset += size;
+    if (offset >= size) offset = 0.0;
+    return start + offset;
+}
+
+} // namespace
+
+void triangulate_periodic(
+    const godot::PackedVector2Array& points,
+    const godot::Rect2& domain,
+    Delaunator& result,
+    std::vector<godot::Vector2i>& wrap_offsets)
+{
+    const double x0 = domain.position.x;
+    const double y0 = domain.position.y;
+    const double width = domain.size.x;
+    const double height = domain.size.y;
+    if (!(width > 0.0 && height > 0.0)) {
+        throw std::runtime_error("periodic domain has no area");
+    }
+
+    const std::size_t n = points.size();
+    godot::PackedVector2Array wrapped;
+    wrapped.resize(n);
+    godot::Vector2 *wrapped_ptr = wrapped.ptrw();
+    for (std::size_t i = 0; i < n; i++) {
+        wrapped_ptr[i] = godot::Vector2(
+            static_cast<real_t>(wrap(points[i].x, x0, width)),
+            static_cast<real_t>(wrap(points[i].y, y0, height)));
+    }
+
+    result = Delaunator();
+    result.m_points = wrapped;
+    wrap_offsets.clear();
+    if (n == 0) return;
+
+    // Points which wrap onto the same position are copied once, as the
+    // earliest of them. Otherwise different copies could skip different
+    // ones as duplicates.
+    std::vector<std::size_t> sources(n);
+    for (std::size_t i = 0; i < n; i++) {
+        sources[i] = i;
+    }
+    std::sort(sources.begin(), sources.end(), [wrapped_ptr](std::size_t i, std::size_t j) {
+        return std::tie(wrapped_ptr[i].x, wrapped_ptr[i].y, i) < std::tie(wrapped_ptr[j].x, wrapped_ptr[j].y, j);
+    });
+    std::size_t unique_count = 0;
+    for (std::size_t k = 0; k < n; k++) {
+        if (unique_count > 0 && wrapped_ptr[sources[k]] == wrapped_ptr[sources[unique_count - 1]]) {
+            result.skipped.push_back(sources[k]);
+        } else {
+            sources[unique_count++] = sources[k];
+        }
+    }
+    sources.resize(unique_count);
+    std::sort(result.skipped.begin(), result.skipped.end());
+    std::vector<std::size_t> rank(n);
+    for (std::size_t k = 0; k < unique_count; k++) {
+        rank[sources[k]] = k;
+    }
+
+    // Start with a band a few average point spacings wide. No circle through
+    // three points of the torus with none inside it is wider than the
+    // domain's diagonal, so a band that wide is always enough.
+    const double max_band = std::sqrt(width * width + height * height);
+    double band = std::min(max_band, 3.0 * std::sqrt(width * height / static_cast<double>(unique_count)));
+
+    std::vector<Copy> copies;
+    godot::PackedVector2Array copy_points;
+    std::vector<Point> exact_points;
+    std::vector<std::size_t> kept;
+
+    while (true) {
+        const double min_x = x0 - band;
+        const double min_y = y0 - band;
+        const double max_x = x0 + width + band;
+        const double max_y = y0 + height + band;
+        const int reach_x = static_cast<int>(std::ceil(band / width));
+        const int reach_y = static_cast<int>(std::ceil(band / height));
+        if ((2.0 * reach_x + 1.0) * (2.0 * reach_y + 1.0) * unique_count > MAX_COPY_WORK) {
+            throw std::runtime_error("periodic domain is too narrow for its points");
+        }
+
+        copies.clear();
+        for (int offset_y = -reach_y; offset_y <= reach_y; offset_y++) {
+            for (int offset_x = -reach_x; offset_x <= reach_x; offset_x++) {
+                for (const std::size_t i : sources) {
+                    const double x = wrapped_ptr[i].x + offset_x * width;
+                    const double y = wrapped_ptr[i].y + offset_y * height;
+                    if (x < min_x || x > max_x || y < min_y || y > max_y) continue;
+                    copies.push_back({ i, godot::Vector2i(offset_x, offset_y) });
+                }
+            }
+        }
+        copy_points.resize(copies.size());
+        godot::Vector2 *copy_ptr = copy_points.ptrw();
+        exact_points.resize(copies.size());
+        for (std::size_t c = 0; c < copies.size(); c++) {
+            const godot::Vector2& p = wrapped_ptr[copies[c].source];
+            exact_points[c] = Point(p.x + copies[c].offset.x * width, p.y + copies[c].offset.y * height);
+            copy_ptr[c] = godot::Vector2(static_cast<real_t>(exact_points[c].x()), static_cast<real_t>(exact_points[c].y()));
+        }
+        // a narrow band across a long thin domain can hold a single line
+        // of copies
+        if (exactly_collinear(copy_points) && band < max_band) {
+            band = std::min(max_band, band * 2.0);
+            continue;
+        }
+
+        Delaunator swept(copy_points);
+        const std::vector<std::size_t>& triangles = swept.triangles;
+
+        // The copies have to be triangulated the same way wherever they
+        // are, which the sweep doesn't promise: it breaks ties between
+        // cocircular points by the order it adds them, and rounding makes
+        // shifted copies differ slightly. So the edges are flipped until
+        // they pass the exact in-circle test on the unrounded copies, with
+        // each tie going to the diagonal through the least of the four
+        // copies by source point, then offset, as shifting a copy doesn't
+        // change that order. This is a symbolic perturbation, which makes
+        // the triangulation unique.
+        const std::vector<std::size_t>& halfedges = swept.halfedges;
+        const bool flipped = swept.restore_delaunay([&](std::size_t a) {
+            const std::size_t i0 = triangles[a];
+            const std::size_t i1 = triangles[next_halfedge(a)];
+            const std::size_t i2 = triangles[prev_halfedge(a)];
+            const std::size_t i3 = triangles[prev_halfedge(halfedges[a])];
+            // the triangles wind clockwise, which flips the sign
+            const int sign = exact_in_circle(exact_points[i2], exact_points[i0], exact_points[i1], exact_points[i3]);
+            if (sign != 0) return sign < 0;
+            std::size_t least = i0;
+            for (const std::size_t i : { i1, i2, i3 }) {
+                if (copies[i] < copies[least]) least = i;
+            }
+            return least == i2 || least == i3;
+        }, halfedges.size());
+        if (!flipped) {
+            throw std::runtime_error("periodic triangulation needed too many flips");
+        }
+
+        // Each triangle of the torus appears once for every copy of it in
+        // the sweep. Keep the copy whose least vertex (by source point, then
+        // offset) is the unshifted point.
+        kept.clear();
+        bool covered = true;
+        for (std::size_t e0 = 0; e0 < triangles.size(); e0 += 3) {
+            const Copy& owner = (std::min)({ copies[triangles[e0]], copies[triangles[e0 + 1]], copies[triangles[e0 + 2]] });
+            if (owner.offset.x != 0 || owner.offset.y != 0) continue;
+            kept.push_back(e0);
+
+            // The triangle can only be trusted if its circumcircle is inside
+            // the band, as any point outside the band wasn't copied
+            const godot::Vector2& a = copy_points[triangles[e0]];
+            const Point center = circumcenter(a, copy_points[triangles[e0 + 1]], copy_points[triangles[e0 + 2]]);
+            const double radius = std::sqrt(Point::dist2(center, Point(a.x, a.y)));
+            if (!(center.x() - radius >= min_x && center.x() + radius <= max_x &&
+                  center.y() - radius >= min_y && center.y() + radius <= max_y)) {
+                covered = false;
+            }
+        }
+        if (!covered && band < max_band) {
+            band = std::min(max_band, band * 2.0);
+            continue;
+        }
+
+        result.triangles.resize(3 * kept.size());
+        result.halfedges.assign(3 * kept.size(), INVALID_INDEX);
+        wrap_offsets.resize(3 * kept.size());
+
+        // An edge of the torus is identified by its source points and the
+        // offset between their copies, which makes finding the twin of a
+        // halfedge that crosses a seam a lookup.
+        const std::uint64_t span_x = 4 * reach_x + 1;
+        const std::uint64_t span_y = 4 * reach_y + 1;
+        auto edge_key = [&](const Copy& a, const Copy& b) {
+            const std::uint64_t offset = (b.offset.x - a.offset.x + 2 * reach_x) * span_y + (b.offset.y - a.offset.y + 2 * reach_y);
+            return (static_cast<std::uint64_t>(rank[a.source]) * unique_count + rank[b.source]) * span_x * span_y + offset;
+        };
+        std::unordered_map<std::uint64_t, std::size_t> edges;
+        edges.reserve(result.triangles.size());
+
+        // A triangle whose owning copy needed a point outside the band is
+        // missing, which leaves the halfedges around it without twins (or
+        // two triangles claiming the same edge). The torus is only closed
+        // if every halfedge pairs up and, as Euler's formula gives for a
+        // torus, there are two triangles per triangulated point.
+        bool closed = true;
+        std::vector<bool> used(n, false);
+        std::size_t used_count = 0;
+        for (std::size_t t = 0; t < kept.size(); t++) {
+            for (std::size_t k = 0; k < 3; k++) {
+                const std::size_t e = kept[t] + k;
+                const Copy& a = copies[triangles[e]];
+                const Copy& b = copies[triangles[next_halfedge(e)]];
+                result.triangles[3 * t + k] = a.source;
+                wrap_offsets[3 * t + k] = a.offset;
+                if (!edges.emplace(edge_key(a, b), 3 * t + k).second) closed = false;
+                if (!used[a.source]) {
+                    used[a.source] = true;
+                    used_count++;
+                }
+            }
+        }
+        for (std::size_t t = 0; t < kept.size(); t++) {
+            for (std::size_t k = 0; k < 3; k++) {
+                const std::size_t e = kept[t] + k;
+                const auto twin = edges.find(edge_key(copies[triangles[next_halfedge(e)]], copies[triangles[e]]));
+                if (twin != edges.end()) {
+                    result.halfedges[3 * t + k] = twin->second;
+                } else {
+                    closed = false;
+                }
+            }
+        }
+        if (used_count == 0 || kept.size() != 2 * used_count) closed = false;
+
+        if (!closed) {
+            if (band < max_band) {
+                band = std::min(max_band, band * 2.0);
+                continue;
+            }
+            // every triangle's circumcircle fits in the widest band, so
+            // this is a bug rather than the band being too narrow
+            throw std::runtime_error("periodic triangulation doesn't close up");
+        }
+
+        // points the sweep skipped as near-duplicates
+        if (used_count < unique_count) {
+            for (const std::size_t i : sources) {
+                if (!used[i]) result.skipped.push_back(i);
+            }
+            std::sort(result.skipped.begin(), result.skipped.end());
+        }
+        return;
+    }
+}
+
+} //namespace delaunator_cpp
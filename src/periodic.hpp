@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// Triangulates points on a torus, where 'domain' wraps horizontally and
+// vertically.
+//
+// 'result' receives the points wrapped into the domain, and triangles and
+// halfedges which only index those points. Every halfedge has a twin, so
+// there is no hull, and there are two triangles per triangulated point.
+// Points which wrap onto an earlier point are left out, and listed in
+// result.skipped. 'wrap_offsets' receives, for each halfedge e, how many
+// domain widths and heights point triangles[e] is shifted by to give its
+// position in that triangle.
+//
+// Only the points near the edges of the domain are copied across the seams,
+// in a band which is widened until every seam triangle's circumcircle fits
+// in it and the triangles close up around the torus. Ties between cocircular
+// points are broken the same way in every copy. Throws std::runtime_error if
+// the domain has no area, or is too narrow for so few points to be copied
+// across it in reasonable time.
+void triangulate_periodic(
+    const godot::PackedVector2Array& points,
+    const godot::Rect2& domain,
+    Delaunator& result,
+    std::vector<godot::Vector2i>& wrap_offsets);
+
+} //namespace delaunator_cpp
@@ -8,14 +8,26 @@
 
 
 #include "gddelaunator.h"
+#include "gddelaunator_fuzzer.h"
+#include "gddelaunator_result.h"
+#include "gddelaunator_tile_set.h"
+#include "parallel.hpp"
 
 using namespace godot;
 
 void register_delaunator_types() {
 	ClassDB::register_class<Delaunator>();
+	ClassDB::register_class<DelaunatorResult>();
+	ClassDB::register_class<DelaunatorTileSet>();
+#ifdef DEBUG_ENABLED
+	ClassDB::register_class<DelaunatorFuzzer>();
+#endif
 }
 
-void unregister_delaunator_types() {}
+void unregister_delaunator_types() {
+	// the worker threads can't outlive the library's code
+	delaunator_cpp::stop_workers();
+}
 
 extern "C" {
 
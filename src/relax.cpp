@@ -0,0 +1,204 @@
+#include "relax.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "deduplicate.hpp"
+#include "delaunator_predicates.hpp"
+#include "parallel.hpp"
+#include "path_finding.hpp"
+
+namespace delaunator_cpp {
+
+namespace {
+
+// update_positions() gives up and rebuilds past this, which only happens in
+// the first iterations when the points are still far from their centroids
+constexpr double MAX_FLIP_FRACTION = 0.25;
+
+Point normalized(const Point& v)
+{
+    const double length = std::sqrt(v.magnitude2());
+    return length > 0.0 ? Point(v.x() / length, v.y() / length) : v;
+}
+
+godot::Vector2 clamp_to(const godot::Vector2& p, const godot::Rect2& bounds)
+{
+    const godot::Vector2 end = bounds.position + bounds.size;
+    return godot::Vector2(
+        std::min(std::max(p.x, bounds.position.x), end.x),
+        std::min(std::max(p.y, bounds.position.y), end.y));
+}
+
+// Sutherland-Hodgman: clips 'polygon' to the side of the line
+// coordinate 'axis' == 'value' given by 'keep_below', into 'clipped'.
+void clip_polygon(
+    const std::vector<Point>& polygon,
+    int axis,
+    double value,
+    bool keep_below,
+    std::vector<Point>& clipped)
+{
+    clipped.clear();
+    auto coordinate = [axis](const Point& p) { return axis == 0 ? p.x() : p.y(); };
+    auto inside = [&](const Point& p) { return keep_below ? coordinate(p) <= value : coordinate(p) >= value; };
+
+    for (std::size_t k = 0; k < polygon.size(); k++) {
+        const Point& from = polygon[k];
+        const Point& to = polygon[(k + 1) % polygon.size()];
+        const bool from_inside = inside(from);
+        const bool to_inside = inside(to);
+        if (from_inside != to_inside) {
+            const double t = (value - coordinate(from)) / (coordinate(to) - coordinate(from));
+            clipped.emplace_back(from.x() + t * (to.x() - from.x()), from.y() + t * (to.y() - from.y()));
+        }
+        if (to_inside) {
+            clipped.push_back(to);
+        }
+    }
+}
+
+} // namespace
+
+void relax(Delaunator& delaunator, std::size_t iterations, const godot::Rect2& bounds)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const std::vector<std::size_t>& halfedges = delaunator.halfedges;
+
+    const double min_x = bounds.position.x;
+    const double min_y = bounds.position.y;
+    const double max_x = min_x + bounds.size.x;
+    const double max_y = min_y + bounds.size.y;
+    const Point middle((min_x + max_x) / 2, (min_y + max_y) / 2);
+    const double diagonal = std::sqrt(Point::dist2(Point(min_x, min_y), Point(max_x, max_y)));
+
+    std::vector<std::size_t> inedges;
+    std::vector<Point> centers;
+    std::vector<std::size_t> nearest;
+    std::vector<std::size_t> nudges;
+    for (std::size_t iteration = 0; iteration < iterations && !triangles.empty(); iteration++) {
+        const godot::Vector2 *points = delaunator.m_points.ptr();
+        build_inedges(delaunator, inedges);
+
+        centers.resize(triangles.size() / 3);
+        parallel_for(centers.size(), 4096, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t t = begin; t < end; t++) {
+                const godot::Vector2& a = points[triangles[3 * t]];
+                const godot::Vector2& b = points[triangles[3 * t + 1]];
+                const godot::Vector2& c = points[triangles[3 * t + 2]];
+                centers[t] = circumcenter(a, b, c);
+                if (!std::isfinite(centers[t].x()) || !std::isfinite(centers[t].y())) {
+                    // flat triangle, its center is somewhere far away
+                    centers[t] = Point((a.x + b.x + c.x) / 3.0, (a.y + b.y + c.y) / 3.0);
+                }
+            }
+        });
+
+        godot::PackedVector2Array relaxed = delaunator.m_points;
+        godot::Vector2 *relaxed_ptr = relaxed.ptrw();
+        parallel_for(relaxed.size(), 1024, [&](std::size_t begin, std::size_t end) {
+            std::vector<Point> cell;
+            std::vector<Point> clipped;
+            for (std::size_t i = begin; i < end; i++) {
+                const std::size_t start = inedges[i];
+                if (start == INVALID_INDEX) {
+                    relaxed_ptr[i] = clamp_to(points[i], bounds);
+                    continue;
+                }
+
+                // the circumcenters around the point, and for hull points far
+                // points out along the rays of the cell's two open edges
+                cell.clear();
+                std::size_t e = start;
+                do {
+                    cell.push_back(centers[e / 3]);
+                    const std::size_t outgoing = next_halfedge(e);
+                    e = halfedges[outgoing];
+                    if (e == INVALID_INDEX) {
+                        const godot::Vector2& p = points[i];
+                        const godot::Vector2& in = points[triangles[start]];
+                        const godot::Vector2& out = points[triangles[next_halfedge(outgoing)]];
+                        // outward normals of the hull edges in -> p and p -> out
+                        const Point in_normal = normalized(Point(-(static_cast<double>(p.y) - in.y), static_cast<double>(p.x) - in.x));
+                        const Point out_normal = normalized(Point(-(static_cast<double>(out.y) - p.y), static_cast<double>(out.x) - p.x));
+
+                        // far enough from where they start to be well outside bounds
+                        auto far_point = [&](const Point& from, const Point& direction) {
+                            const double distance = std::sqrt(Point::dist2(from, middle)) + 2 * diagonal;
+                            return Point(from.x() + direction.x() * distance, from.y() + direction.y() * distance);
+                        };
+                        const Point first = cell.front();
+                        const Point last = cell.back();
+                        cell.push_back(far_point(last, out_normal));
+                        cell.push_back(far_point(Point(p.x, p.y), normalized(Point(in_normal.x() + out_normal.x(), in_normal.y() + out_normal.y()))));
+                        cell.push_back(far_point(first, in_normal));
+                        break;
+                    }
+                } while (e != start);
+
+                bool inside = true;
+                for (const Point& v : cell) {
+                    inside = inside && v.x() >= min_x && v.x() <= max_x && v.y() >= min_y && v.y() <= max_y;
+                }
+                if (!inside) {
+                    clip_polygon(cell, 0, min_x, false, clipped);
+                    clip_polygon(clipped, 0, max_x, true, cell);
+                    clip_polygon(cell, 1, min_y, false, clipped);
+                    clip_polygon(clipped, 1, max_y, true, cell);
+                }
+
+                // centroid relative to the first vertex, to keep the
+                // products small
+                double area = 0.0;
+                double cx = 0.0;
+                double cy = 0.0;
+                for (std::size_t k = 1; k + 1 < cell.size(); k++) {
+                    const double ax = cell[k].x() - cell[0].x();
+                    const double ay = cell[k].y() - cell[0].y();
+                    const double bx = cell[k + 1].x() - cell[0].x();
+                    const double by = cell[k + 1].y() - cell[0].y();
+                    const double cross = ax * by - ay * bx;
+                    area += cross;
+                    cx += (ax + bx) * cross;
+                    cy += (ay + by) * cross;
+                }
+                if (area != 0.0) {
+                    relaxed_ptr[i] = clamp_to(godot::Vector2(
+                        static_cast<real_t>(cell[0].x() + cx / (3 * area)),
+                        static_cast<real_t>(cell[0].y() + cy / (3 * area))), bounds);
+                } else {
+                    relaxed_ptr[i] = clamp_to(points[i], bounds);
+                }
+            }
+        });
+
+        // Points the sweep skipped as duplicates have no cell, and while
+        // any are left out update_positions() can only rebuild. Each moves
+        // halfway to the centroid of a triangle around the point it
+        // duplicates, a different triangle for each duplicate of a point,
+        // so the next triangulation includes it.
+        if (!delaunator.skipped.empty()) {
+            nearest.resize(relaxed.size());
+            remap_skipped(delaunator, nearest);
+            nudges.assign(relaxed.size(), 0);
+            for (const std::size_t i : delaunator.skipped) {
+                const std::size_t j = nearest[i];
+                if (j == INVALID_INDEX || inedges[j] == INVALID_INDEX) continue;
+                std::size_t e = inedges[j];
+                for (std::size_t k = nudges[j]++; k > 0; k--) {
+                    const std::size_t around = halfedges[next_halfedge(e)];
+                    if (around == INVALID_INDEX || around == inedges[j]) break;
+                    e = around;
+                }
+                const std::size_t t = e / 3;
+                const godot::Vector2 centroid = (points[triangles[3 * t]] + points[triangles[3 * t + 1]] + points[triangles[3 * t + 2]]) / 3;
+                relaxed_ptr[i] = clamp_to((points[j] + centroid) / 2, bounds);
+            }
+        }
+
+        delaunator.update_positions(relaxed, MAX_FLIP_FRACTION);
+    }
+}
+
+} //namespace delaunator_cpp
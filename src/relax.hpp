@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+#include <godot_cpp/variant/rect2.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// Lloyd's algorithm: moves every point to the centroid of its Voronoi cell
+// clipped to 'bounds', 'iterations' times, leaving the triangulation of the
+// final points in 'delaunator' (whose points are the ones relaxed). The
+// cells of hull points are closed with rays out along their hull edges'
+// normals. Points the sweep skipped as duplicates are moved into a triangle
+// beside the point they duplicate, so they're triangulated from the next
+// iteration on; any other points which aren't triangulated are just
+// clamped to 'bounds'.
+//
+// The centroids are found on separate threads, and the triangulation is
+// repaired with update_positions() between iterations rather than rebuilt,
+// since each iteration moves the points less.
+//
+// Throws std::runtime_error if an iteration leaves the points all on one
+// line, as clamping points from far outside 'bounds' onto one side can;
+// 'delaunator' is then left with the previous iteration's points.
+void relax(Delaunator& delaunator, std::size_t iterations, const godot::Rect2& bounds);
+
+} //namespace delaunator_cpp
@@ -0,0 +1,420 @@
+#include "tile_set.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+#include "delaunator_predicates.hpp"
+#include "parallel.hpp"
+#include "validate.hpp"
+
+namespace delaunator_cpp {
+
+namespace {
+
+inline std::uint64_t tile_id(const godot::Vector2i& key)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(key.x)) << 32) |
+           static_cast<std::uint32_t>(key.y);
+}
+
+inline int tile_distance(const godot::Vector2i& a, const godot::Vector2i& b)
+{
+    return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+}
+
+// p is beyond the edge a->b when the cross product is positive, as the
+// triangles all have a negative winding
+inline bool beyond(const godot::Vector2& a, const godot::Vector2& b, const godot::Vector2& p)
+{
+    return (static_cast<double>(b.x) - a.x) * (static_cast<double>(p.y) - a.y) -
+           (static_cast<double>(b.y) - a.y) * (static_cast<double>(p.x) - a.x) > 0.0;
+}
+
+inline bool rect_beyond(const godot::Rect2& rect, const godot::Vector2& a, const godot::Vector2& b)
+{
+    const godot::Vector2 end = rect.position + rect.size;
+    return beyond(a, b, rect.position) ||
+           beyond(a, b, godot::Vector2(end.x, rect.position.y)) ||
+           beyond(a, b, godot::Vector2(rect.position.x, end.y)) ||
+           beyond(a, b, end);
+}
+
+// Tiles include their top and left edges but not their bottom and right
+inline bool tile_contains(const godot::Rect2& rect, const godot::Vector2& p)
+{
+    return p.x >= rect.position.x && p.y >= rect.position.y &&
+           p.x < rect.position.x + rect.size.x && p.y < rect.position.y + rect.size.y;
+}
+
+inline bool circle_inside(const Point& center, double radius_squared, const godot::Rect2& rect)
+{
+    const double r = std::sqrt(radius_squared);
+    return center.x() - r > rect.position.x && center.x() + r < rect.position.x + rect.size.x &&
+           center.y() - r > rect.position.y && center.y() + r < rect.position.y + rect.size.y;
+}
+
+inline bool circle_meets(const Point& center, double radius_squared, const godot::Rect2& rect)
+{
+    const double dx = std::max({ rect.position.x - center.x(), 0.0, center.x() - (rect.position.x + rect.size.x) });
+    const double dy = std::max({ rect.position.y - center.y(), 0.0, center.y() - (rect.position.y + rect.size.y) });
+    return dx * dx + dy * dy <= radius_squared;
+}
+
+// The tile key of the tile p is in, or false if it's further out than any
+// key can reach
+inline bool tile_key(const godot::Vector2& p, double tile_size, godot::Vector2i& key)
+{
+    const double x = std::floor(p.x / tile_size);
+    const double y = std::floor(p.y / tile_size);
+    constexpr double LOWEST = std::numeric_limits<std::int32_t>::min();
+    constexpr double HIGHEST = std::numeric_limits<std::int32_t>::max();
+    if (!(x >= LOWEST && x <= HIGHEST && y >= LOWEST && y <= HIGHEST)) return false;
+    key = godot::Vector2i(static_cast<int32_t>(x), static_cast<int32_t>(y));
+    return true;
+}
+
+// The sweep, or an empty triangulation for points it can't triangulate.
+// This runs on the pool's threads, so the sweep's exception for points
+// all on one line (tested exactly, as the sweep does) is caught here too.
+bool try_triangulate(const godot::PackedVector2Array& points, Delaunator& result)
+{
+    if (!exactly_collinear(points)) {
+        try {
+            result = Delaunator(points);
+            return true;
+        } catch (const std::runtime_error&) {
+        }
+    }
+    result = Delaunator();
+    return false;
+}
+
+} // namespace
+
+TileSet::TileSet(double tile_size) : m_tile_size(tile_size)
+{
+}
+
+void TileSet::triangulate(Tile& tile, const godot::Rect2& rect)
+{
+    const godot::Vector2 *p = tile.points.ptr();
+    const std::size_t n = tile.points.size();
+
+    godot::Vector2 min = n > 0 ? p[0] : godot::Vector2();
+    godot::Vector2 max = min;
+    for (std::size_t i = 1; i < n; i++) {
+        min = godot::Vector2(std::min(min.x, p[i].x), std::min(min.y, p[i].y));
+        max = godot::Vector2(std::max(max.x, p[i].x), std::max(max.y, p[i].y));
+    }
+    tile.bounds = godot::Rect2(min, max - min);
+
+    tile.interior.clear();
+    tile.point_triangle.clear();
+    tile.band.clear();
+    if (!try_triangulate(tile.points, tile.triangulation)) {
+        // without triangles, every point is left to the seams
+        for (std::size_t i = 0; i < n; i++) {
+            tile.band.push_back(i);
+        }
+        return;
+    }
+    const std::vector<std::size_t>& triangles = tile.triangulation.triangles;
+
+    std::vector<bool> in_band(n, false);
+    tile.interior.resize(triangles.size() / 3);
+    tile.point_triangle.assign(n, INVALID_INDEX);
+    for (std::size_t t = 0; t < tile.interior.size(); t++) {
+        tile.point_triangle[triangles[3 * t]] = t;
+        tile.point_triangle[triangles[3 * t + 1]] = t;
+        tile.point_triangle[triangles[3 * t + 2]] = t;
+        const godot::Vector2& a = p[triangles[3 * t]];
+        const godot::Vector2& b = p[triangles[3 * t + 1]];
+        const godot::Vector2& c = p[triangles[3 * t + 2]];
+        tile.interior[t] = circle_inside(circumcenter(a, b, c), circumradius(a, b, c), rect);
+        if (!tile.interior[t]) {
+            in_band[triangles[3 * t]] = true;
+            in_band[triangles[3 * t + 1]] = true;
+            in_band[triangles[3 * t + 2]] = true;
+        }
+    }
+
+    // the hull points' triangles don't surround them, so they can always
+    // gain neighbours in other tiles
+    const Delaunator& d = tile.triangulation;
+    std::size_t e = d.hull_start;
+    do {
+        in_band[e] = true;
+        e = d.hull_next[e];
+    } while (e != d.hull_start);
+
+    for (std::size_t i = 0; i < n; i++) {
+        if (in_band[i]) tile.band.push_back(i);
+    }
+}
+
+godot::Rect2 TileSet::get_tile_rect(const godot::Vector2i& key) const
+{
+    return godot::Rect2(
+        static_cast<real_t>(key.x * m_tile_size),
+        static_cast<real_t>(key.y * m_tile_size),
+        static_cast<real_t>(m_tile_size),
+        static_cast<real_t>(m_tile_size));
+}
+
+void TileSet::load_tiles(
+    const std::vector<godot::Vector2i>& keys,
+    const std::vector<godot::PackedVector2Array>& points)
+{
+    std::vector<Tile> loaded(keys.size());
+    parallel_for(keys.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            loaded[i].key = keys[i];
+            loaded[i].points = points[i];
+            triangulate(loaded[i], get_tile_rect(keys[i]));
+        }
+    });
+
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        m_tiles[tile_id(keys[i])] = std::move(loaded[i]);
+    }
+    stitch(keys);
+}
+
+void TileSet::unload_tiles(const std::vector<godot::Vector2i>& keys)
+{
+    for (const godot::Vector2i& key : keys) {
+        m_tiles.erase(tile_id(key));
+    }
+    stitch(keys);
+}
+
+const TileSet::Tile* TileSet::get_tile(const godot::Vector2i& key) const
+{
+    const auto found = m_tiles.find(tile_id(key));
+    return found == m_tiles.end() ? nullptr : &found->second;
+}
+
+std::vector<godot::Vector2i> TileSet::get_loaded_tiles() const
+{
+    std::vector<godot::Vector2i> keys;
+    keys.reserve(m_tiles.size());
+    for (const auto& entry : m_tiles) {
+        keys.push_back(entry.second.key);
+    }
+    return keys;
+}
+
+void TileSet::stitch(const std::vector<godot::Vector2i>& changed)
+{
+    std::vector<Tile*> affected;
+    for (auto& entry : m_tiles) {
+        Tile& tile = entry.second;
+        for (const godot::Vector2i& key : changed) {
+            bool affects = tile_distance(tile.key, key) <= tile.reach;
+
+            // A tile loaded further out only matters if its points could be
+            // inside a seam triangle's circumcircle or beyond one of the
+            // seams' hull edges; unloading one can't change them.
+            const Tile* other = get_tile(key);
+            if (!affects && other && other->points.size() > 0) {
+                const godot::Vector2 end = other->bounds.position + other->bounds.size;
+                const godot::Vector2 extent_end = tile.extent.position + tile.extent.size;
+                affects = tile.complete ||
+                          (end.x >= tile.extent.position.x && other->bounds.position.x <= extent_end.x &&
+                           end.y >= tile.extent.position.y && other->bounds.position.y <= extent_end.y);
+                for (const auto& edge : tile.open_edges) {
+                    affects = affects || rect_beyond(other->bounds, edge.first, edge.second);
+                }
+            }
+            if (affects) {
+                affected.push_back(&tile);
+                break;
+            }
+        }
+    }
+
+    parallel_for(affected.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            stitch_tile(*affected[i]);
+        }
+    });
+}
+
+// The triangles of the whole triangulation that aren't interior to a tile
+// only use band points, so they're also triangles of the band points'
+// triangulation. One of those belongs to the whole triangulation if no
+// points from further out than the neighbourhood the band points came from
+// are inside its circumcircle, and it doesn't overlap an interior triangle.
+// If a triangle around this tile's points fails the first test, or points
+// further out could be beyond the hull of the band points, the
+// neighbourhood is widened.
+//
+// Seam triangles belong to the tile of their first point, ordering the
+// points by tile and then index, which is always a loaded tile.
+void TileSet::stitch_tile(Tile& tile) const
+{
+    const godot::Rect2 rect = get_tile_rect(tile.key);
+    const Delaunator& own = tile.triangulation;
+
+    for (int reach = 1;; reach *= 2) {
+        // the tile's own band points come first
+        std::vector<const Tile*> sources = { &tile };
+        std::vector<const Tile*> outside;
+        for (const auto& entry : m_tiles) {
+            const Tile& other = entry.second;
+            if (&other == &tile) continue;
+            if (tile_distance(other.key, tile.key) <= reach) {
+                sources.push_back(&other);
+            } else if (other.points.size() > 0) {
+                outside.push_back(&other);
+            }
+        }
+
+        std::size_t band_size = 0;
+        for (const Tile* source : sources) {
+            band_size += source->band.size();
+        }
+        godot::PackedVector2Array band_points;
+        band_points.resize(band_size);
+        godot::Vector2 *band_ptr = band_points.ptrw();
+        std::vector<std::pair<std::size_t, std::size_t>> band_sources;
+        band_sources.reserve(band_size);
+        for (std::size_t s = 0; s < sources.size(); s++) {
+            const godot::Vector2 *p = sources[s]->points.ptr();
+            for (std::size_t i : sources[s]->band) {
+                band_ptr[band_sources.size()] = p[i];
+                band_sources.emplace_back(s, i);
+            }
+        }
+
+        tile.reach = reach;
+        tile.complete = outside.empty();
+        tile.open_edges.clear();
+        tile.vertices = tile.points;
+        tile.triangles.clear();
+        tile.borrowed.clear();
+
+        for (std::size_t t = 0; t < tile.interior.size(); t++) {
+            if (!tile.interior[t]) continue;
+            tile.triangles.push_back(own.triangles[3 * t]);
+            tile.triangles.push_back(own.triangles[3 * t + 1]);
+            tile.triangles.push_back(own.triangles[3 * t + 2]);
+        }
+        Delaunator seams;
+        if (!try_triangulate(band_points, seams)) return;
+        const godot::Vector2 *p = band_points.ptr();
+        const real_t margin = static_cast<real_t>(reach * m_tile_size);
+        const godot::Rect2 neighbourhood(
+            rect.position - godot::Vector2(margin, margin),
+            rect.size + godot::Vector2(2 * margin, 2 * margin));
+
+        auto owner = [&](std::size_t band_point) {
+            const godot::Vector2i& key = sources[band_sources[band_point].first]->key;
+            return std::make_tuple(key.x, key.y, band_sources[band_point].second);
+        };
+        // the walk to p starts from one of the triangle's points when it's
+        // in the same tile
+        auto overlaps_interior = [&](const godot::Vector2& p, const std::size_t (&corners)[3]) {
+            godot::Vector2i key;
+            if (!tile_key(p, m_tile_size, key)) return false;
+            const Tile* other = key == tile.key ? &tile : get_tile(key);
+            if (!other || other->interior.empty()) return false;
+
+            std::size_t start = 0;
+            for (std::size_t corner : corners) {
+                if (sources[band_sources[corner].first] == other) {
+                    start = other->point_triangle[band_sources[corner].second];
+                }
+            }
+            const std::size_t inside = other->triangulation.locate(p, start);
+            return inside != INVALID_INDEX && other->interior[inside];
+        };
+
+        godot::Vector2 extent_min = neighbourhood.position;
+        godot::Vector2 extent_max = neighbourhood.position + neighbourhood.size;
+        bool widen = false;
+        std::vector<std::size_t> kept;
+        for (std::size_t t = 0; t < seams.triangles.size() / 3 && !widen; t++) {
+            const std::size_t i0 = seams.triangles[3 * t];
+            const std::size_t i1 = seams.triangles[3 * t + 1];
+            const std::size_t i2 = seams.triangles[3 * t + 2];
+            if (band_sources[i0].first != 0 && band_sources[i1].first != 0 && band_sources[i2].first != 0) continue;
+
+            const godot::Vector2& a = p[i0];
+            const godot::Vector2& b = p[i1];
+            const godot::Vector2& c = p[i2];
+            if (!tile.complete) {
+                const Point center = circumcenter(a, b, c);
+                const double radius_squared = circumradius(a, b, c);
+                if (!circle_inside(center, radius_squared, neighbourhood)) {
+                    // near the hull, circles reach out over empty space
+                    for (const Tile* other : outside) {
+                        widen = widen || circle_meets(center, radius_squared, other->bounds);
+                    }
+                    const double r = std::sqrt(radius_squared);
+                    extent_min = godot::Vector2(
+                        std::min(extent_min.x, static_cast<real_t>(center.x() - r)),
+                        std::min(extent_min.y, static_cast<real_t>(center.y() - r)));
+                    extent_max = godot::Vector2(
+                        std::max(extent_max.x, static_cast<real_t>(center.x() + r)),
+                        std::max(extent_max.y, static_cast<real_t>(center.y() + r)));
+                }
+            }
+
+            if (band_sources[std::min({ i0, i1, i2 }, [&](std::size_t l, std::size_t r) { return owner(l) < owner(r); })].first != 0) continue;
+            const std::size_t corners[3] = { i0, i1, i2 };
+            if (overlaps_interior((a + b + c) / 3.0, corners)) continue;
+            kept.push_back(t);
+        }
+
+        if (!widen && !tile.complete) {
+            std::size_t e = seams.hull_start;
+            do {
+                const std::size_t next = seams.hull_next[e];
+                const godot::Vector2& a = p[e];
+                const godot::Vector2& b = p[next];
+                if (band_sources[e].first == 0 || band_sources[next].first == 0 || rect_beyond(rect, a, b)) {
+                    for (const Tile* other : outside) {
+                        widen = widen || rect_beyond(other->bounds, a, b);
+                    }
+                    tile.open_edges.emplace_back(a, b);
+                }
+                e = next;
+            } while (e != seams.hull_start);
+        }
+        if (widen) continue;
+        tile.extent = godot::Rect2(extent_min, extent_max - extent_min);
+
+        std::unordered_map<std::size_t, std::size_t> vertex_of_band_point;
+        for (std::size_t t : kept) {
+            for (std::size_t k = 0; k < 3; k++) {
+                const std::size_t band_point = seams.triangles[3 * t + k];
+                const std::size_t source = band_sources[band_point].first;
+                const std::size_t i = band_sources[band_point].second;
+                if (source == 0) {
+                    tile.triangles.push_back(i);
+                    continue;
+                }
+
+                const auto found = vertex_of_band_point.find(band_point);
+                if (found != vertex_of_band_point.end()) {
+                    tile.triangles.push_back(found->second);
+                    continue;
+                }
+                const std::size_t vertex = tile.vertices.size();
+                vertex_of_band_point.emplace(band_point, vertex);
+                tile.vertices.push_back(p[band_point]);
+                tile.borrowed.emplace_back(sources[source]->key, i);
+                tile.triangles.push_back(vertex);
+            }
+        }
+        return;
+    }
+}
+
+} //namespace delaunator_cpp
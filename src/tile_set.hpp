@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// The Delaunay triangulation of the points in a grid of square tiles, which
+// are loaded and unloaded independently. Tile (x, y) covers
+// [x * tile_size, (x + 1) * tile_size) horizontally, and the same vertically,
+// and its points must lie inside it.
+//
+// Each tile is triangulated on its own. The triangles whose circumcircles
+// lie inside the tile can't be changed by any other tile's points, so only
+// the rest (the band along its edges and around sparse areas) is
+// triangulated again, from the band points of the tiles around it, when a
+// neighbour is loaded or unloaded. Only loaded tiles are kept.
+class TileSet {
+public:
+    struct Tile {
+        godot::Vector2i key;
+        godot::PackedVector2Array points;
+
+        // The tile's share of the triangulation of all the loaded points:
+        // its interior triangles, and the seam triangles whose least point,
+        // ordering the points by tile and then index, is one of its own.
+        // 'triangles' indexes 'vertices', which are the tile's own points
+        // followed by the neighbours' points that its seam triangles use.
+        godot::PackedVector2Array vertices;
+        std::vector<std::size_t> triangles;
+
+        // Where 'vertices' past the tile's own points come from, as
+        // (tile, point index) pairs
+        std::vector<std::pair<godot::Vector2i, std::size_t>> borrowed;
+
+    private:
+        friend class TileSet;
+
+        // The tile's points triangulated on their own, and which of those
+        // triangles have circumcircles inside the tile
+        Delaunator triangulation;
+        std::vector<bool> interior;
+        // A triangle using each point, to start walks from
+        std::vector<std::size_t> point_triangle;
+        // Points used by triangles which aren't interior, or on the hull
+        std::vector<std::size_t> band;
+        godot::Rect2 bounds;
+
+        // How many tiles out the seams' neighbourhood reached; the seams
+        // are stitched again when a tile that close changes
+        int reach = 1;
+        // True if the neighbourhood held every loaded tile, so the seams
+        // weren't checked against tiles further out
+        bool complete = false;
+        // Bounds of the seam triangles' circumcircles, which tiles loaded
+        // there could change
+        godot::Rect2 extent;
+        // Hull edges of the seams' triangulation that tiles further out
+        // could still be beyond
+        std::vector<std::pair<godot::Vector2, godot::Vector2>> open_edges;
+    };
+
+    explicit TileSet(double tile_size);
+
+    double get_tile_size() const { return m_tile_size; }
+
+    // Triangulates the tiles (replacing them if they're already loaded) on
+    // separate threads, then stitches the seams of every tile they affect.
+    void load_tiles(
+        const std::vector<godot::Vector2i>& keys,
+        const std::vector<godot::PackedVector2Array>& points);
+    void unload_tiles(const std::vector<godot::Vector2i>& keys);
+
+    // nullptr if the tile isn't loaded
+    const Tile* get_tile(const godot::Vector2i& key) const;
+    std::vector<godot::Vector2i> get_loaded_tiles() const;
+
+    godot::Rect2 get_tile_rect(const godot::Vector2i& key) const;
+
+private:
+    double m_tile_size;
+    std::unordered_map<std::uint64_t, Tile> m_tiles;
+
+    static void triangulate(Tile& tile, const godot::Rect2& rect);
+    void stitch(const std::vector<godot::Vector2i>& changed);
+    void stitch_tile(Tile& tile) const;
+};
+
+} //namespace delaunator_cpp
@@ -0,0 +1,142 @@
+#include "traversal.hpp"
+
+#include <utility>
+
+namespace delaunator_cpp {
+
+namespace {
+
+inline bool can_cross(const Delaunator& delaunator, const std::uint8_t *edge_mask, std::size_t e)
+{
+    const std::size_t twin = delaunator.halfedges[e];
+    return twin != INVALID_INDEX && (!edge_mask || (edge_mask[e] && edge_mask[twin]));
+}
+
+// Adds the triangles reachable from 'seed' which aren't marked in 'visited'
+// to 'reached', marking them.
+void fill_from(
+    const Delaunator& delaunator,
+    std::size_t seed,
+    const std::uint8_t *edge_mask,
+    std::vector<bool>& visited,
+    std::vector<std::size_t>& reached)
+{
+    // 'reached' doubles as the queue
+    std::size_t head = reached.size();
+    visited[seed] = true;
+    reached.push_back(seed);
+    while (head < reached.size()) {
+        const std::size_t t = reached[head++];
+        for (std::size_t e = 3 * t; e < 3 * t + 3; e++) {
+            if (!can_cross(delaunator, edge_mask, e)) continue;
+            const std::size_t neighbor = delaunator.halfedges[e] / 3;
+            if (!visited[neighbor]) {
+                visited[neighbor] = true;
+                reached.push_back(neighbor);
+            }
+        }
+    }
+}
+
+} // namespace
+
+std::vector<std::size_t> flood_fill(
+    const Delaunator& delaunator,
+    std::size_t seed,
+    const std::uint8_t *edge_mask)
+{
+    std::vector<std::size_t> reached;
+    const std::size_t triangle_count = delaunator.triangles.size() / 3;
+    if (seed >= triangle_count) return reached;
+
+    std::vector<bool> visited(triangle_count, false);
+    fill_from(delaunator, seed, edge_mask, visited, reached);
+    return reached;
+}
+
+std::vector<std::size_t> connected_components(
+    const Delaunator& delaunator,
+    const std::uint8_t *edge_mask,
+    std::size_t& count)
+{
+    const std::size_t triangle_count = delaunator.triangles.size() / 3;
+    std::vector<std::size_t> labels(triangle_count, INVALID_INDEX);
+    std::vector<bool> visited(triangle_count, false);
+    std::vector<std::size_t> component;
+
+    count = 0;
+    for (std::size_t seed = 0; seed < triangle_count; seed++) {
+        if (visited[seed]) continue;
+        component.clear();
+        fill_from(delaunator, seed, edge_mask, visited, component);
+        for (std::size_t t : component) {
+            labels[t] = count;
+        }
+        count++;
+    }
+    return labels;
+}
+
+std::vector<std::vector<godot::Vector2>> contours(
+    const Delaunator& delaunator,
+    const float *values,
+    float level)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const std::vector<std::size_t>& halfedges = delaunator.halfedges;
+    const godot::PackedVector2Array& points = delaunator.m_points;
+
+    // Points at the level count as above it, so every crossed edge has one
+    // end above and one below, and a triangle is crossed on two edges or
+    // none. Of those two, the halfedge running from above to below is where
+    // the line enters the triangle, and the other is where it leaves; the
+    // twin of the exit runs from above to below, so is the next entry.
+    auto above = [&](std::size_t e) { return values[triangles[e]] >= level; };
+    auto crossed = [&](std::size_t e) { return above(e) != above(next_halfedge(e)); };
+    auto crossing = [&](std::size_t e) {
+        // interpolated from the end above, so both halfedges of an edge give
+        // exactly the same point
+        std::size_t from = triangles[e];
+        std::size_t to = triangles[next_halfedge(e)];
+        if (values[from] < level) std::swap(from, to);
+        const double t = (static_cast<double>(level) - values[from]) / (static_cast<double>(values[to]) - values[from]);
+        return godot::Vector2(
+            static_cast<real_t>(points[from].x + t * (static_cast<double>(points[to].x) - points[from].x)),
+            static_cast<real_t>(points[from].y + t * (static_cast<double>(points[to].y) - points[from].y)));
+    };
+    auto exit_of = [&](std::size_t entry) {
+        const std::size_t e = next_halfedge(entry);
+        return crossed(e) ? e : next_halfedge(e);
+    };
+
+    std::vector<std::vector<godot::Vector2>> lines;
+    std::vector<bool> visited(triangles.size() / 3, false);
+    auto trace = [&](std::size_t entry) {
+        std::vector<godot::Vector2> line;
+        line.push_back(crossing(entry));
+        std::size_t e = entry;
+        while (e != INVALID_INDEX && !visited[e / 3]) {
+            visited[e / 3] = true;
+            const std::size_t exit = exit_of(e);
+            line.push_back(crossing(exit));
+            e = halfedges[exit];
+        }
+        lines.push_back(std::move(line));
+    };
+
+    // lines which end on the hull start on it, at an entry with no twin
+    for (std::size_t e = 0; e < triangles.size(); e++) {
+        if (halfedges[e] == INVALID_INDEX && crossed(e) && above(e)) {
+            trace(e);
+        }
+    }
+    // everything left is a loop
+    for (std::size_t e = 0; e < triangles.size(); e++) {
+        if (!visited[e / 3] && crossed(e) && above(e)) {
+            trace(e);
+        }
+    }
+    return lines;
+}
+
+} //namespace delaunator_cpp
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <godot_cpp/variant/vector2.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// 'edge_mask' below has one entry per halfedge, or is null to allow every
+// edge. An edge can be crossed when the entries of both its halfedges are
+// nonzero, so clearing either one blocks it.
+
+// The triangles reachable from 'seed' by crossing edges, in breadth first
+// order starting with 'seed'.
+std::vector<std::size_t> flood_fill(
+    const Delaunator& delaunator,
+    std::size_t seed,
+    const std::uint8_t *edge_mask);
+
+// Labels each triangle with the index of its connected component, numbered
+// in order of each component's lowest triangle. Returns the labels and
+// sets 'count' to the number of components.
+std::vector<std::size_t> connected_components(
+    const Delaunator& delaunator,
+    const std::uint8_t *edge_mask,
+    std::size_t& count);
+
+// The lines where the linear interpolation of the per-point 'values' equals
+// 'level' (marching triangles). Each line runs with the higher values on its
+// left, as seen with y pointing down. Lines which close end with their first
+// point repeated; the others start and end on the hull.
+std::vector<std::vector<godot::Vector2>> contours(
+    const Delaunator& delaunator,
+    const float *values,
+    float level);
+
+} //namespace delaunator_cpp
@@ -0,0 +1,389 @@
+#include "validate.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace delaunator_cpp {
+
+namespace {
+
+// Expansion arithmetic (Shewchuk, "Adaptive Precision Floating-Point
+// Arithmetic and Fast Robust Geometric Predicates"): a value is held exactly
+// as a sum of doubles which don't overlap, in increasing magnitude, so its
+// sign is the sign of the last one.
+using Expansion = std::vector<double>;
+
+constexpr double HALF_EPSILON = std::numeric_limits<double>::epsilon() / 2;
+
+inline void two_sum(double a, double b, double& sum, double& error)
+{
+    sum = a + b;
+    const double b_virtual = sum - a;
+    const double a_virtual = sum - b_virtual;
+    error = (a - a_virtual) + (b - b_virtual);
+}
+
+// Adds b to e, dropping the zeros the sums leave.
+void grow(Expansion& e, double b)
+{
+    Expansion result;
+    result.reserve(e.size() + 1);
+    double q = b;
+    for (double component : e) {
+        double error;
+        two_sum(q, component, q, error);
+        if (error != 0.0) result.push_back(error);
+    }
+    if (q != 0.0) result.push_back(q);
+    e.swap(result);
+}
+
+Expansion difference(double a, double b)
+{
+    Expansion e;
+    grow(e, a);
+    grow(e, -b);
+    return e;
+}
+
+Expansion sum(Expansion a, const Expansion& b)
+{
+    for (double component : b) {
+        grow(a, component);
+    }
+    return a;
+}
+
+Expansion negated(Expansion e)
+{
+    for (double& component : e) {
+        component = -component;
+    }
+    return e;
+}
+
+Expansion product(const Expansion& a, const Expansion& b)
+{
+    Expansion e;
+    for (double x : a) {
+        for (double y : b) {
+            const double p = x * y;
+            grow(e, p);
+            grow(e, std::fma(x, y, -p));
+        }
+    }
+    return e;
+}
+
+// A fixed-capacity expansion, for when the differences are exact and the
+// size of every expansion is known, so nothing is allocated.
+template <std::size_t N>
+struct FixedExpansion {
+    double terms[N];
+    std::size_t size = 0;
+
+    // as grow(), in place: each component is read before it's overwritten
+    void grow(double b)
+    {
+        // most product errors are zero for the points that tie
+        if (b == 0.0) return;
+        double q = b;
+        std::size_t kept = 0;
+        for (std::size_t k = 0; k < size; k++) {
+            double error;
+            two_sum(q, terms[k], q, error);
+            if (error != 0.0) terms[kept++] = error;
+        }
+        if (q != 0.0) terms[kept++] = q;
+        size = kept;
+    }
+
+    // adds x * y, which is exactly the rounded product and its error
+    void grow_product(double x, double y)
+    {
+        const double p = x * y;
+        grow(std::fma(x, y, -p));
+        grow(p);
+    }
+
+    int sign() const
+    {
+        return size == 0 ? 0 : (terms[size - 1] > 0.0 ? 1 : -1);
+    }
+};
+
+// a - b, if it's exactly a double
+inline bool exact_difference(double a, double b, double& result)
+{
+    double error;
+    two_sum(a, -b, result, error);
+    return error == 0.0;
+}
+
+inline int sign(const Expansion& e)
+{
+    return e.empty() ? 0 : (e.back() > 0.0 ? 1 : -1);
+}
+
+inline int sign(double value)
+{
+    return (value > 0.0) - (value < 0.0);
+}
+
+int in_circle_sign(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy)
+{
+    const double adx = ax - dx;
+    const double ady = ay - dy;
+    const double bdx = bx - dx;
+    const double bdy = by - dy;
+    const double cdx = cx - dx;
+    const double cdy = cy - dy;
+
+    const double bdxcdy = bdx * cdy;
+    const double cdxbdy = cdx * bdy;
+    const double alift = adx * adx + ady * ady;
+    const double cdxady = cdx * ady;
+    const double adxcdy = adx * cdy;
+    const double blift = bdx * bdx + bdy * bdy;
+    const double adxbdy = adx * bdy;
+    const double bdxady = bdx * ady;
+    const double clift = cdx * cdx + cdy * cdy;
+
+    const double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+    const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift +
+                             (std::abs(cdxady) + std::abs(adxcdy)) * blift +
+                             (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+    const double bound = (10.0 + 96.0 * HALF_EPSILON) * HALF_EPSILON * permanent;
+    if (std::abs(det) > bound) return sign(det);
+
+    // Points close enough for the filter to fail usually have differences
+    // which are exact, as they always are for points within a factor of two
+    // of each other (Sterbenz). Then each lift and cross product is a sum of
+    // four doubles and the determinant of at most 96.
+    double ex[6];
+    if (exact_difference(ax, dx, ex[0]) && exact_difference(ay, dy, ex[1]) &&
+        exact_difference(bx, dx, ex[2]) && exact_difference(by, dy, ex[3]) &&
+        exact_difference(cx, dx, ex[4]) && exact_difference(cy, dy, ex[5])) {
+        FixedExpansion<96> exact;
+        for (std::size_t k = 0; k < 3; k++) {
+            const double ux = ex[2 * k], uy = ex[2 * k + 1];
+            const double vx = ex[(2 * k + 2) % 6], vy = ex[(2 * k + 3) % 6];
+            const double wx = ex[(2 * k + 4) % 6], wy = ex[(2 * k + 5) % 6];
+            FixedExpansion<4> lift;
+            lift.grow_product(ux, ux);
+            lift.grow_product(uy, uy);
+            FixedExpansion<4> cross;
+            cross.grow_product(vx, wy);
+            cross.grow_product(-wx, vy);
+            for (std::size_t i = 0; i < lift.size; i++) {
+                for (std::size_t j = 0; j < cross.size; j++) {
+                    exact.grow_product(lift.terms[i], cross.terms[j]);
+                }
+            }
+        }
+        return exact.sign();
+    }
+
+    const Expansion adx_exact = difference(ax, dx);
+    const Expansion ady_exact = difference(ay, dy);
+    const Expansion bdx_exact = difference(bx, dx);
+    const Expansion bdy_exact = difference(by, dy);
+    const Expansion cdx_exact = difference(cx, dx);
+    const Expansion cdy_exact = difference(cy, dy);
+
+    auto lift = [](const Expansion& x, const Expansion& y) {
+        return sum(product(x, x), product(y, y));
+    };
+    auto cross = [](const Expansion& ux, const Expansion& uy, const Expansion& vx, const Expansion& vy) {
+        return sum(product(ux, vy), negated(product(vx, uy)));
+    };
+    Expansion exact = product(lift(adx_exact, ady_exact), cross(bdx_exact, bdy_exact, cdx_exact, cdy_exact));
+    exact = sum(exact, product(lift(bdx_exact, bdy_exact), cross(cdx_exact, cdy_exact, adx_exact, ady_exact)));
+    exact = sum(exact, product(lift(cdx_exact, cdy_exact), cross(adx_exact, ady_exact, bdx_exact, bdy_exact)));
+    return sign(exact);
+}
+
+} // namespace
+
+int exact_orientation(const godot::Vector2& a, const godot::Vector2& b, const godot::Vector2& c)
+{
+    const double left = (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y);
+    const double right = (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - a.x);
+    const double det = left - right;
+    const double bound = (3.0 + 16.0 * HALF_EPSILON) * HALF_EPSILON * (std::abs(left) + std::abs(right));
+    if (std::abs(det) > bound) return sign(det);
+
+    double bax, bay, cax, cay;
+    if (exact_difference(b.x, a.x, bax) && exact_difference(b.y, a.y, bay) &&
+        exact_difference(c.x, a.x, cax) && exact_difference(c.y, a.y, cay)) {
+        FixedExpansion<4> exact;
+        exact.grow_product(bax, cay);
+        exact.grow_product(-bay, cax);
+        return exact.sign();
+    }
+
+    const Expansion left_exact = product(difference(b.x, a.x), difference(c.y, a.y));
+    const Expansion right_exact = product(difference(b.y, a.y), difference(c.x, a.x));
+    return sign(sum(left_exact, negated(right_exact)));
+}
+
+int exact_in_circle(
+    const godot::Vector2& a,
+    const godot::Vector2& b,
+    const godot::Vector2& c,
+    const godot::Vector2& d)
+{
+    return in_circle_sign(a.x, a.y, b.x, b.y, c.x, c.y, d.x, d.y);
+}
+
+int exact_in_circle(const Point& a, const Point& b, const Point& c, const Point& d)
+{
+    return in_circle_sign(a.x(), a.y(), b.x(), b.y(), c.x(), c.y(), d.x(), d.y());
+}
+
+bool exactly_collinear(const godot::PackedVector2Array& points)
+{
+    const std::size_t n = points.size();
+    std::size_t second = 1;
+    while (second < n && points[second] == points[0]) {
+        second++;
+    }
+    for (std::size_t i = second + 1; i < n; i++) {
+        if (exact_orientation(points[0], points[second], points[i]) != 0) return false;
+    }
+    return true;
+}
+
+std::string validate(const Delaunator& delaunator, const std::vector<std::size_t>& point_remap)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const std::vector<std::size_t>& halfedges = delaunator.halfedges;
+    const godot::PackedVector2Array& points = delaunator.m_points;
+    const std::size_t n = points.size();
+    const std::size_t halfedge_count = triangles.size();
+
+    if (halfedge_count % 3 != 0) return "triangles has " + std::to_string(halfedge_count) + " entries, not a multiple of 3";
+    if (halfedges.size() != halfedge_count) return "halfedges and triangles differ in size";
+    if (delaunator.hull_start == INVALID_INDEX) return "no hull";
+    if (delaunator.hull_next.size() != n || delaunator.hull_prev.size() != n || delaunator.hull_tri.size() != n) {
+        return "hull arrays don't have an entry per point";
+    }
+
+    // points
+    std::vector<bool> used(n, false);
+    for (std::size_t e = 0; e < halfedge_count; e++) {
+        if (triangles[e] >= n) return "halfedge " + std::to_string(e) + " starts at missing point " + std::to_string(triangles[e]);
+        used[triangles[e]] = true;
+    }
+    std::size_t used_count = std::count(used.begin(), used.end(), true);
+    std::vector<bool> left_out(n, false);
+    for (std::size_t i : delaunator.skipped) {
+        if (i >= n || used[i]) return "skipped point " + std::to_string(i) + " is triangulated";
+        left_out[i] = true;
+    }
+    for (std::size_t j = 0; j < point_remap.size() && j < n; j++) {
+        if (point_remap[j] != j && !used[j]) left_out[j] = true;
+    }
+    for (std::size_t j = 0; j < n; j++) {
+        if (!used[j] && !left_out[j]) return "point " + std::to_string(j) + " is neither triangulated nor skipped";
+    }
+
+    // halfedges
+    for (std::size_t e = 0; e < halfedge_count; e++) {
+        const std::size_t twin = halfedges[e];
+        if (twin == INVALID_INDEX) continue;
+        if (twin >= halfedge_count || twin == e || halfedges[twin] != e) {
+            return "halfedge " + std::to_string(e) + " and its twin " + std::to_string(twin) + " don't pair up";
+        }
+        if (triangles[twin] != triangles[next_halfedge(e)] || triangles[next_halfedge(twin)] != triangles[e]) {
+            return "halfedge " + std::to_string(e) + " and its twin " + std::to_string(twin) + " don't join the same points";
+        }
+    }
+
+    // triangles
+    for (std::size_t t = 0; t < halfedge_count / 3; t++) {
+        const godot::Vector2& a = points[triangles[3 * t]];
+        const godot::Vector2& b = points[triangles[3 * t + 1]];
+        const godot::Vector2& c = points[triangles[3 * t + 2]];
+        const int orientation = exact_orientation(a, b, c);
+        if (orientation >= 0) {
+            return "triangle " + std::to_string(t) + (orientation == 0 ? " is degenerate" : " is inverted");
+        }
+    }
+    for (std::size_t e = 0; e < halfedge_count; e++) {
+        const std::size_t twin = halfedges[e];
+        if (twin == INVALID_INDEX || twin < e) continue;
+        const std::size_t t = e / 3;
+        const godot::Vector2& opposite = points[triangles[prev_halfedge(twin)]];
+        // the triangles wind clockwise, which flips the sign
+        if (exact_in_circle(points[triangles[3 * t]], points[triangles[3 * t + 1]], points[triangles[3 * t + 2]], opposite) < 0) {
+            return "edge of halfedge " + std::to_string(e) + " isn't Delaunay";
+        }
+    }
+
+    // hull
+    std::size_t hull_size = 0;
+    std::size_t i = delaunator.hull_start;
+    do {
+        if (i >= n || !used[i]) return "hull runs through untriangulated point " + std::to_string(i);
+        if (++hull_size > used_count) return "hull doesn't close";
+        const std::size_t next = delaunator.hull_next[i];
+        if (next >= n || delaunator.hull_prev[next] != i) return "hull_next and hull_prev disagree at point " + std::to_string(i);
+        const std::size_t e = delaunator.hull_tri[i];
+        if (e >= halfedge_count || triangles[e] != i || triangles[next_halfedge(e)] != next || halfedges[e] != INVALID_INDEX) {
+            return "hull_tri of point " + std::to_string(i) + " isn't the hull edge to the next";
+        }
+        if (exact_orientation(points[delaunator.hull_prev[i]], points[i], points[next]) > 0) {
+            return "hull isn't convex at point " + std::to_string(i);
+        }
+        i = next;
+    } while (i != delaunator.hull_start);
+
+    const std::size_t boundary_count = std::count(halfedges.begin(), halfedges.end(), INVALID_INDEX);
+    if (boundary_count != hull_size) {
+        return std::to_string(boundary_count) + " halfedges have no twin, but the hull has " + std::to_string(hull_size) + " edges";
+    }
+    if (halfedge_count / 3 + hull_size + 2 != 2 * used_count) {
+        return std::to_string(halfedge_count / 3) + " triangles, but " + std::to_string(used_count) +
+               " points with " + std::to_string(hull_size) + " on the hull need " + std::to_string(2 * used_count - hull_size - 2);
+    }
+
+    // skipped points, which the sweep drops when they're within CMP_EPSILON
+    // on each axis of a point, or within 1e-10 of the points' span
+    if (!delaunator.skipped.empty()) {
+        double min_x = std::numeric_limits<double>::max();
+        double min_y = std::numeric_limits<double>::max();
+        double max_x = std::numeric_limits<double>::lowest();
+        double max_y = std::numeric_limits<double>::lowest();
+        for (std::size_t j = 0; j < n; j++) {
+            min_x = std::min<double>(min_x, points[j].x);
+            min_y = std::min<double>(min_y, points[j].y);
+            max_x = std::max<double>(max_x, points[j].x);
+            max_y = std::max<double>(max_y, points[j].y);
+        }
+        const double span = (max_x - min_x) * (max_x - min_x) + (max_y - min_y) * (max_y - min_y);
+        const double tolerance = std::max(2.0 * CMP_EPSILON * CMP_EPSILON, 1e-20 * span);
+
+        auto near = [&](std::size_t skipped, std::size_t j) {
+            const double dx = static_cast<double>(points[skipped].x) - points[j].x;
+            const double dy = static_cast<double>(points[skipped].y) - points[j].y;
+            return used[j] && dx * dx + dy * dy <= tolerance;
+        };
+        for (std::size_t skipped : delaunator.skipped) {
+            bool found = false;
+            const std::size_t t = delaunator.locate(points[skipped]);
+            if (t != INVALID_INDEX) {
+                found = near(skipped, triangles[3 * t]) || near(skipped, triangles[3 * t + 1]) || near(skipped, triangles[3 * t + 2]);
+            }
+            for (std::size_t j = 0; !found && j < n; j++) {
+                found = near(skipped, j);
+            }
+            if (!found) return "skipped point " + std::to_string(skipped) + " isn't a duplicate";
+        }
+    }
+    return std::string();
+}
+
+} //namespace delaunator_cpp
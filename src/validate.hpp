@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// Exact signs of the geometric predicates, whatever the rounding of the
+// points' coordinates: a double precision filter decides most cases, and
+// the rest are evaluated in arbitrary precision. Slower than the
+// triangulation's own predicates, but never wrong, so they can be used to
+// check it.
+
+// Positive if a, b, c turn counterclockwise with y pointing up, negative if
+// clockwise, 0 if they're collinear.
+int exact_orientation(const godot::Vector2& a, const godot::Vector2& b, const godot::Vector2& c);
+
+// Positive if d lies inside the circle through a, b, c when those turn
+// counterclockwise (the sign flips when they turn clockwise), 0 if the four
+// are cocircular.
+int exact_in_circle(
+    const godot::Vector2& a,
+    const godot::Vector2& b,
+    const godot::Vector2& c,
+    const godot::Vector2& d);
+
+// As above, for points with double precision coordinates.
+int exact_in_circle(const Point& a, const Point& b, const Point& c, const Point& d);
+
+// True if every point lies on one line (which includes there being fewer
+// than three distinct points).
+bool exactly_collinear(const godot::PackedVector2Array& points);
+
+// Checks a triangulation from the sweep or from update_positions() with
+// exact predicates, returning a description of the first problem found, or
+// an empty string if there's none:
+//  - the halfedges pair up with twins running the opposite way,
+//  - every triangle winds clockwise (with y up) and no edge is illegal, ie.
+//    has the opposite point strictly inside its circumcircle,
+//  - the hull links up, runs along the halfedges without twins, and is
+//    convex, and the triangle count matches the points and hull size,
+//  - every point is triangulated except the skipped ones, and those lie
+//    within the sweep's duplicate tolerance of a triangulated point.
+// Passing all of these makes it a Delaunay triangulation of the points,
+// since a triangulation of the convex hull whose edges are all locally
+// Delaunay is globally Delaunay. Periodic triangulations have no hull and
+// aren't checked. Points which deduplicate() merged into another, per
+// 'point_remap', aren't expected to be triangulated.
+std::string validate(
+    const Delaunator& delaunator,
+    const std::vector<std::size_t>& point_remap = std::vector<std::size_t>());
+
+} //namespace delaunator_cpp
@@ -0,0 +1,22 @@
+#include "voronoi.hpp"
+
+#include "delaunator_predicates.hpp"
+
+namespace delaunator_cpp {
+
+void circumcenters(const Delaunator& delaunator, std::vector<godot::Vector2>& centers)
+{
+    const std::vector<std::size_t>& triangles = delaunator.triangles;
+    const godot::Vector2 *points = delaunator.m_points.ptr();
+
+    centers.resize(triangles.size() / 3);
+    for (std::size_t t = 0; t < centers.size(); t++) {
+        const Point center = circumcenter(
+            points[triangles[3 * t]],
+            points[triangles[3 * t + 1]],
+            points[triangles[3 * t + 2]]);
+        centers[t] = godot::Vector2(static_cast<real_t>(center.x()), static_cast<real_t>(center.y()));
+    }
+}
+
+} //namespace delaunator_cpp
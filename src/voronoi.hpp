@@ -0,0 +1,15 @@
+#pragma once
+
+#include <vector>
+
+#include <godot_cpp/variant/vector2.hpp>
+
+#include "delaunator.hpp"
+
+namespace delaunator_cpp {
+
+// Fills 'centers' with the circumcenter of every triangle (the vertices of
+// the Voronoi diagram), indexed by triangle (halfedge / 3).
+void circumcenters(const Delaunator& delaunator, std::vector<godot::Vector2>& centers);
+
+} //namespace delaunator_cpp